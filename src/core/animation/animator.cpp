@@ -4,6 +4,9 @@
 
 #include "system/io.h"
 
+#include <algorithm>
+#include <cmath>
+
 namespace core
 {
 
@@ -18,6 +21,8 @@ Animator::~Animator()
 void Animator::play()
 {
 	mIsStop = false;
+	mDroppedFrameCount = 0;
+	sync();
 }
 void Animator::stop()
 {
@@ -25,21 +30,66 @@ void Animator::stop()
 	mCurrentFrameNo = static_cast<uint32_t>(mCurrentFrameNo);
 }
 
+void Animator::setPreviewFps(uint32_t previewFps)
+{
+	mPreviewFps = previewFps;
+	sync();
+}
+
+void Animator::sync()
+{
+	const double fps = mFps > 0 ? mFps : 1.0;
+	const double previewFps = mPreviewFps > 0 ? mPreviewFps : fps;
+
+	mTime = (mCurrentFrameNo - static_cast<double>(mMinFrameNo)) / fps;
+	mStep = static_cast<int64_t>(std::floor(mTime * previewFps));
+	mClockFrameNo = mCurrentFrameNo;
+}
+
 void Animator::update()
 {
+	mDirty = false;
 	if (mIsStop)
 		return;
 
-	mCurrentFrameNo += io::deltaTime * mFps * mSpeed;
+	if (mCurrentFrameNo != mClockFrameNo)
+	{
+		sync();
+	}
+
+	const double fps = mFps > 0 ? mFps : 1.0;
+	const double previewFps = mPreviewFps > 0 ? mPreviewFps : fps;
+	mTime += static_cast<double>(io::deltaTime) * mSpeed;
+
+	const int64_t step = static_cast<int64_t>(std::floor(mTime * previewFps));
+	const int64_t advance = std::abs(step - mStep);
+	if (advance == 0)
+		return;
+	if (advance > 1)
+	{
+		mDroppedFrameCount += static_cast<uint32_t>(advance - 1);
+	}
+	mStep = step;
 
-	if (mSpeed < 0 && mCurrentFrameNo < 0.0f)
+	// the step is mapped into [mMinFrameNo, mMaxFrameNo], looping in both directions. a loop lasts span + 1 frames
+	// so the last frame is shown for a whole frame like the others, sub-frame steps past it hold it
+	const double span = static_cast<double>(mMaxFrameNo) - mMinFrameNo;
+	double frame = static_cast<double>(step) * fps / previewFps;
+	if (span > 0.0)
 	{
-		mCurrentFrameNo = mMaxFrameNo;
+		frame = std::fmod(frame, span + 1.0);
+		if (frame < 0.0)
+			frame += span + 1.0;
+		frame = std::min(frame, span);
 	}
-	else if (mSpeed > 0 && mCurrentFrameNo > mMaxFrameNo)
+	else
 	{
-		mCurrentFrameNo = mMinFrameNo;
+		frame = 0.0;
 	}
+
+	mCurrentFrameNo = static_cast<float>(mMinFrameNo + frame);
+	mClockFrameNo = mCurrentFrameNo;
+	mDirty = true;
 }
 
-}	 // namespace core
\ No newline at end of file
+}	 // namespace core
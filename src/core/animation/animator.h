@@ -2,12 +2,16 @@
 #define _CORE_ANIMATION_MANAGER_H_
 
 #include <numeric>
+#include <cstdint>
 
 namespace core
 {
 
 class AnimationCreatorCanvas;
 
+// playback clock. time is accumulated in seconds and mapped to fixed steps of the preview rate,
+// so mCurrentFrameNo only moves (and the scene only re-evaluates) when the step index changes,
+// independently of how often update() is called
 class Animator
 {
 public:
@@ -17,20 +21,42 @@ public:
 	void play();
 	void stop();
 	void update();
+	// changes the preview rate without a jump of the clock (the timeline toolbar edits it while playing)
+	void setPreviewFps(uint32_t previewFps);
 
 	uint32_t mMinFrameNo{0u};
 	uint32_t mMaxFrameNo{200u};
 	float mCurrentFrameNo{0.0f};
 	uint32_t mFps{24u};
+	// evaluation steps per second while playing, 0 follows mFps (whole frames only).
+	// a higher rate previews sub-frames, e.g. 48 evaluates every half frame of a 24 fps composition
+	uint32_t mPreviewFps{0u};
 	float mSpeed{1.0f};
 
+	// keyframe tracks are sampled over [mMinFrameNo, mMaxFrameNo] in the background of the updates,
+	// scrubbing and playback then read the samples instead of interpolating
+	bool mIsBake{true};
+	// baked samples are stored as 16 bits per channel, about 1/65535 of the value range of each track
+	bool mIsQuantizeBake{false};
+
 	bool mIsStop{true};
-	bool mDirty{false};
+	bool mDirty{false};	   // mCurrentFrameNo moved in the last update (or was scrubbed)
+
+	// steps skipped since play() because an update came later than one step, shown in the timeline toolbar
+	uint32_t mDroppedFrameCount{0u};
+
+private:
+	// restarts the clock from mCurrentFrameNo (after play or a scrub)
+	void sync();
 
 private:
 	AnimationCreatorCanvas* rCanvas{nullptr};
+
+	double mTime{0.0};	  // seconds since mMinFrameNo, never rounded
+	int64_t mStep{0};	  // step index of mTime at the preview rate
+	float mClockFrameNo{0.0f};	  // last frame written by the clock, anything else is a scrub
 };
 
 }	 // namespace core
 
-#endif
\ No newline at end of file
+#endif
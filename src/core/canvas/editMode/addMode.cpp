@@ -56,8 +56,8 @@ bool AddMode::onDragLeftMouse(const InputValue& inputValue)
 bool AddMode::onEndLeftMouse(const InputValue& inputValue)
 {
 	auto& world = rCanvas->mMainScene->mSceneEntity.getComponent<WorldTransformComponent>();
-	auto endPoint = inputValue.get<Vec2>() * world.inverseWorldTransform;
-	auto startPoint = mContext.startPoint * world.inverseWorldTransform;
+	auto endPoint = inputValue.get<Vec2>() * world.inverseWorldTransform();
+	auto startPoint = mContext.startPoint * world.inverseWorldTransform();
 	auto start = Vec2{std::min(startPoint.x, endPoint.x), std::min(startPoint.y, endPoint.y)};
 	auto end = Vec2{std::max(startPoint.x, endPoint.x), std::max(startPoint.y, endPoint.y)};
 
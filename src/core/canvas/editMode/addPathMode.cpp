@@ -3,6 +3,7 @@
 #include "scene/ui/editPath.h"
 #include "canvas/animationCreatorCanvas.h"
 #include "scene/component/components.h"
+#include "scene/component/pathSimplify.h"
 
 namespace core
 {
@@ -29,7 +30,7 @@ bool AddPathMode::onStarClickLefttMouse(const InputValue& inputValue)
 	{
 		PathPoints pathPoints;
 		auto& world = rCanvas->mMainScene->mSceneEntity.getComponent<WorldTransformComponent>();
-		auto pos = start * world.inverseWorldTransform;
+		auto pos = start * world.inverseWorldTransform();
 		mTargetPath = rCanvas->mMainScene->createPathLayer(pathPoints);
 		mEditPath =
 			std::make_unique<EditPath>(rCanvas->getInputController(), rCanvas->mControlScene.get(), mTargetPath);
@@ -60,6 +61,16 @@ bool AddPathMode::onEndLeftMouse(const InputValue& inputValue)
 		if (!mTargetPath.hasComponent<SolidFillComponent>())
 			mTargetPath.addComponent<SolidFillComponent>();
 		Resolve(mTargetPath.getComponent<TransformComponent>(), *rawPath);
+		rawPath->markChanged();
+		if (static_cast<int>(rawPath->path.size()) >= CommonSetting::Count_PathSimplifyMinPoint)
+		{
+			auto result = SimplifyPath(*rawPath, CommonSetting::Threshold_PathSimplifyTolerance);
+			if (result.isSimplified)
+			{
+				LOG_INFO("simplify path: {} -> {} points, error {}", result.inputPointCount, result.outputPointCount,
+						 result.maxError);
+			}
+		}
 
 		mTargetPath.setDirty(Dirty::Type::Path | Dirty::Type::Transform);
 
@@ -30,14 +30,14 @@ bool PickMode::onDoubleClickLeftMouse(const InputValue& inputValue)
 {
 	auto pos = inputValue.get<Vec2>();
 	mContext.pickInfo.currentSelectedPaint = nullptr;
-	bool isPick = Pick(rCanvas->mMainScene->getScene(), mContext.pickInfo, pos);
+	bool isPick = Pick(rCanvas->mMainScene.get(), mContext.pickInfo, pos);
 	bool isNeedReset = false;
 	if (isPick && mContext.pickInfo.type == PickInfo::Type::Shape)
 	{
 		auto targetId = mContext.pickInfo.currentSelectedPaint->id;
 		auto targetEntity = mContext.pickInfo.currentSelectedScene->getEntityById(targetId);
 		SelectionManager::Select(rCanvas, targetEntity);
-		mContext.pickInfo.excludeIds.insert(targetId);
+		mContext.pickInfo.excludeIds.push_back(targetId);
 		return true;
 	}
 	else
@@ -61,7 +61,7 @@ bool PickMode::onStarClickLefttMouse(const InputValue& inputValue)
 	mContext.startPoint = inputValue.get<Vec2>();
 	mContext.beforePoint = mContext.startPoint;
 
-	bool isPick = Pick(rCanvas->mMainScene->getScene(), mContext.pickInfo, mContext.startPoint);
+	bool isPick = Pick(rCanvas->mMainScene.get(), mContext.pickInfo, mContext.startPoint);
 
 	if (isPick && mContext.pickInfo.type == PickInfo::Type::Shape)
 	{
@@ -76,6 +76,7 @@ bool PickMode::onStarClickLefttMouse(const InputValue& inputValue)
 		if (size.x > sp.x && size.y > sp.y && sp.x > 0 && sp.y > 0)
 		{
 			SelectionManager::Clear(rCanvas);
+			mContext.isMarquee = true;
 		}
 		mContext.pickInfo.currentSelectedPaint = nullptr;
 		mContext.pickInfo.currentSelectedScene = nullptr;
@@ -84,16 +85,45 @@ bool PickMode::onStarClickLefttMouse(const InputValue& inputValue)
 }
 bool PickMode::onDragLeftMouse(const InputValue& inputValue)
 {
+	if (!mContext.isMarquee)
+		return true;
+
+	auto endPoint = inputValue.get<Vec2>();
+	auto startPoint = mContext.startPoint;
+	if (mContext.marquee.isNull() && length(endPoint - startPoint) < CommonSetting::Threshold_MarqueeStart)
+		return true;
+
+	auto minXy = Vec2{std::min(startPoint.x, endPoint.x), std::min(startPoint.y, endPoint.y)};
+	auto maxXy = Vec2{std::max(startPoint.x, endPoint.x), std::max(startPoint.y, endPoint.y)};
+
+	// only the shapes near the rect are visited, through the spatial indices of the main and nested scenes
+	mContext.marqueeEntities.clear();
+	rCanvas->mMainScene->rectCandidates(minXy, maxXy, mContext.marqueeEntities);
+	SelectionManager::Select(rCanvas, mContext.marqueeEntities);
+
+	// the outline is created with the first drag and then only moved
+	const std::array<Vec2, 4> points{minXy, Vec2{maxXy.x, minXy.y}, maxXy, Vec2{minXy.x, maxXy.y}};
+	if (mContext.marquee.isNull())
+	{
+		mContext.marquee = rCanvas->mControlScene->createObb(points);
+		mContext.marquee.getComponent<StrokeComponent>().color = CommonSetting::Color_DefaultMarqueeOutline;
+	}
+	else
+	{
+		rCanvas->mControlScene->updateObb(mContext.marquee, points);
+	}
+
 	return true;
 }
 bool PickMode::onEndLeftMouse(const InputValue& inputValue)
 {
+	endMarquee();
 	return true;
 }
 bool PickMode::onMoveMouse(const InputValue& inputValue)
 {
 	PickInfo pickInfo;
-	bool isPick = Pick(rCanvas->mMainScene->getScene(), pickInfo, inputValue.get<Vec2>());
+	bool isPick = Pick(rCanvas->mMainScene.get(), pickInfo, inputValue.get<Vec2>());
 	if (isPick && pickInfo.type == PickInfo::Type::Shape)
 	{
 		auto target = pickInfo.currentSelectedScene->getEntityById(pickInfo.currentSelectedPaint->id);
@@ -115,6 +145,15 @@ bool PickMode::onInputAttach(const InputValue& inputValue)
 bool PickMode::onInputDetach(const InputValue& inputValue)
 {
 	mContext.isLeftMouseDown = false;
+	endMarquee();
 	return false;
 }
+
+void PickMode::endMarquee()
+{
+	mContext.isMarquee = false;
+	mContext.marqueeEntities.clear();
+	if (!mContext.marquee.isNull())
+		rCanvas->mControlScene->destroyEntity(mContext.marquee);
+}
 }	 // namespace core
\ No newline at end of file
@@ -23,6 +23,11 @@ class PickMode : public EditMode
 		// Entity currentObb;
 		// Entity drag;
 		bool isLeftMouseDown{false};
+
+		// rubber band started from empty space
+		bool isMarquee{false};
+		Entity marquee;	   // outline in the control scene
+		std::vector<Entity> marqueeEntities;
 	};
 
 public:
@@ -39,6 +44,9 @@ public:
 	bool onInputAttach(const InputValue& inputValue) override;
 	bool onInputDetach(const InputValue& inputValue) override;
 
+private:
+	void endMarquee();
+
 private:
 	AnimationCreatorCanvas* rCanvas{nullptr};
 	Context mContext{};
@@ -20,4 +20,58 @@ Line ToLine(const Segment& seg)
 	return line;
 }
 
+bool IsInner(const OutlineComponent& outline, const Vec2& point, tvg::FillRule rule)
+{
+	int winding = 0;
+	int crossing = 0;
+	uint32_t begin = 0;
+	for (auto end : outline.contourEnds)
+	{
+		for (uint32_t i = begin, j = end - 1; i < end; j = i++)
+		{
+			const Vec2& a = outline.points[j];
+			const Vec2& b = outline.points[i];
+			if ((a.y <= point.y) == (b.y <= point.y))
+				continue;
+
+			// the edge crosses the horizontal ray to +x if the point is on its left
+			const float side = cross(b - a, point - a);
+			if (b.y > a.y ? side > 0.0f : side < 0.0f)
+			{
+				winding += b.y > a.y ? 1 : -1;
+				crossing++;
+			}
+		}
+		begin = end;
+	}
+	return rule == tvg::FillRule::EvenOdd ? (crossing & 1) != 0 : winding != 0;
+}
+
+bool IsNear(const OutlineComponent& outline, const Vec2& point, float distance)
+{
+	const float distance2 = distance * distance;
+	auto isNear = [&point, distance2](const Vec2& a, const Vec2& b)
+	{
+		const Vec2 ab = b - a;
+		const float len2 = ab * ab;
+		const float t = len2 > 0.0f ? std::clamp(((point - a) * ab) / len2, 0.0f, 1.0f) : 0.0f;
+		return length2(point - (a + ab * t)) <= distance2;
+	};
+
+	uint32_t begin = 0;
+	for (size_t c = 0; c < outline.contourEnds.size(); c++)
+	{
+		const uint32_t end = outline.contourEnds[c];
+		for (uint32_t i = begin + 1; i < end; i++)
+		{
+			if (isNear(outline.points[i - 1], outline.points[i]))
+				return true;
+		}
+		if (outline.isClosed[c] && isNear(outline.points[end - 1], outline.points[begin]))
+			return true;
+		begin = end;
+	}
+	return false;
+}
+
 }	 // namespace core
\ No newline at end of file
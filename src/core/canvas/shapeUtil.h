@@ -4,9 +4,12 @@
 #include <thorvg.h>
 #include <array>
 #include <list>
+#include <vector>
+#include <algorithm>
 #include "common/common.h"
 
 #include "scene/scene.h"
+#include "scene/component/components.h"
 
 namespace core
 {
@@ -17,16 +20,87 @@ struct Segment;
 float Evaluate(const Line& line, float x);
 Line ToLine(const Segment& seg);
 
-static std::array<Vec2, 4> GetObb(tvg::Paint* p)
+// point inside the filled area of outline (local space), open contours are closed like tvg fills them
+bool IsInner(const OutlineComponent& outline, const Vec2& point, tvg::FillRule rule);
+// point within distance of any segment of outline (local space)
+bool IsNear(const OutlineComponent& outline, const Vec2& point, float distance);
+
+// world transform of an entity with the transform edits queued since the last update applied.
+// input events can arrive several times between two updates, so the readers below do not wait for Scene::onUpdate
+static const WorldTransformComponent& GetWorldTransform(Entity entity)
+{
+	entity.getScene()->updateWorldTransforms();
+	return entity.getComponent<WorldTransformComponent>();
+}
+
+// cached bounds of a shape entity, refreshed if its path, stroke width or world transform changed
+static const BoundsComponent* GetBounds(Entity entity)
+{
+	auto* shape = entity.tryGetComponent<ShapeComponent>();
+	if (shape == nullptr)
+		return nullptr;
+
+	auto& bounds = entity.getOrAddComponent<BoundsComponent>();
+	Update(bounds, *shape, GetWorldTransform(entity), entity.tryGetComponent<StrokeComponent>());
+	return &bounds;
+}
+
+static bool GetObb(tvg::Paint* p, std::array<Vec2, 4>& out);
+
+// world obb of an entity, false if it has no geometry.
+// a scene gets the box of its children in its own space, like tvg::Scene::bounds
+static bool GetObb(Entity entity, std::array<Vec2, 4>& out)
 {
+	if (auto* bounds = GetBounds(entity))
+	{
+		out = bounds->worldObb;
+		return !bounds->isEmpty;
+	}
+
+	auto* scene = entity.tryGetComponent<SceneComponent>();
+	if (scene == nullptr || scene->scene == nullptr)
+		return false;
+
+	const auto& world = GetWorldTransform(entity);
+	const auto& inverse = world.inverseWorldTransform();
+	Vec2 minXy{std::numeric_limits<float>::max(), std::numeric_limits<float>::max()};
+	Vec2 maxXy{std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest()};
+	bool isEmpty = true;
+	for (auto* child : scene->scene->getScene()->paints())
+	{
+		std::array<Vec2, 4> childObb;
+		if (!GetObb(child, childObb))
+			continue;
+		isEmpty = false;
+		for (const auto& p : childObb)
+		{
+			const auto local = p * inverse;
+			minXy = Vec2{std::min(minXy.x, local.x), std::min(minXy.y, local.y)};
+			maxXy = Vec2{std::max(maxXy.x, local.x), std::max(maxXy.y, local.y)};
+		}
+	}
+	if (isEmpty)
+		return false;
+
+	const auto& m = world.worldTransform;
+	out = {minXy * m, Vec2{maxXy.x, minXy.y} * m, maxXy * m, Vec2{minXy.x, maxXy.y} * m};
+	return true;
+}
+
+// paints that are not entities (no id in the entity index) fall back to tvg
+static bool GetObb(tvg::Paint* p, std::array<Vec2, 4>& out)
+{
+	if (auto entity = Scene::FindEntity(p->id); !entity.isNull())
+		return GetObb(entity, out);
+
 	std::array<tvg::Point, 4> pts;
-	std::array<Vec2, 4> ptsVec;
-	p->bounds(pts.data());
-	ptsVec[0] = Vec2{pts[0].x, pts[0].y};
-	ptsVec[1] = Vec2{pts[1].x, pts[1].y};
-	ptsVec[2] = Vec2{pts[2].x, pts[2].y};
-	ptsVec[3] = Vec2{pts[3].x, pts[3].y};
-	return ptsVec;
+	if (p->bounds(pts.data()) != tvg::Result::Success)
+		return false;
+	for (int i = 0; i < 4; i++)
+	{
+		out[i] = Vec2{pts[i].x, pts[i].y};
+	}
+	return true;
 }
 static bool IsInner(const std::array<Vec2, 4>& q, Vec2 p)
 {
@@ -38,9 +112,39 @@ static bool IsInner(const std::array<Vec2, 4>& q, Vec2 p)
 }
 static bool IsInner(tvg::Paint* p, Vec2 point)
 {
-	auto obb = GetObb(p);
-	return IsInner(obb, point);
+	std::array<Vec2, 4> obb;
+	return GetObb(p, obb) && IsInner(obb, point);
+}
+
+// exact test against the flattened outline of a shape: its fill (with the fill rule) and its stroke.
+// run after a coarse obb test, the outline is cached and rebuilt only when the path changes
+static bool IsHit(Entity entity, const Vec2& worldPoint)
+{
+	auto* shape = entity.tryGetComponent<ShapeComponent>();
+	if (shape == nullptr)
+		return false;
+
+	auto& outline = entity.getOrAddComponent<OutlineComponent>();
+	Update(outline, *shape);
+
+	const auto& world = GetWorldTransform(entity);
+	const Vec2 point = worldPoint * world.inverseWorldTransform();
+
+	auto* fill = entity.tryGetComponent<SolidFillComponent>();
+	if (fill && fill->alpha > 0.0f && IsInner(outline, point, fill->rule))
+		return true;
+
+	auto* stroke = entity.tryGetComponent<StrokeComponent>();
+	if (stroke == nullptr || stroke->alpha <= 0.0f)
+		return false;
+
+	// the stroke is scaled with the shape, the pick tolerance is not
+	const auto& m = world.worldTransform;
+	const float scale = std::sqrt(std::abs(m.e11 * m.e22 - m.e12 * m.e21));
+	const float tolerance = scale > 1e-6f ? CommonSetting::Threshold_PickStroke / scale : 0.0f;
+	return IsNear(outline, point, std::max(stroke->width * 0.5f, tolerance));
 }
+
 static Vec2 GetCenter(const std::array<Vec2, 4>& q)
 {
 	return (q[0] + q[1] + q[2] + q[3]) / 4.0f;
@@ -54,42 +158,58 @@ struct PickInfo
 		Scene,
 		Shape
 	};
-	std::unordered_set<uint32_t> excludeIds;
+	std::vector<uint32_t> excludeIds;	 // a few ids, scanned linearly
 	core::Scene* currentSelectedScene{nullptr};
 	tvg::Paint* currentSelectedPaint{nullptr};
 	Type type;
 };
 
-static bool Pick(PickInfo& pickInfo, const Vec2& point, tvg::Paint* paint, int depth)
+// candidates come from the spatial index of each scene, front to back, so the top-most hit wins.
+// the current selection is skipped, so picking the same point again selects the shape below it.
+// a nested scene is searched through its own index (no walk over its children for a box) and counts as hit,
+// so it can be selected itself, when one of its shapes is hit. isHit reports such a hit, even a skipped one
+static bool Pick(PickInfo& pickInfo, const Vec2& point, Scene* scene, bool& isHit)
 {
-	if (!paint || pickInfo.excludeIds.find(paint->id) != pickInfo.excludeIds.end())
-		return false;
+	std::vector<Entity> candidates;
+	scene->pickCandidates(point, candidates);
 
-	const bool isScene = (paint->type() == tvg::Type::Scene);
-	const bool isCurrentSelected = pickInfo.currentSelectedPaint == paint;
-
-	if (IsInner(GetObb(paint), point))
+	for (auto& entity : candidates)
 	{
-		if (isScene)
+		const bool isExcluded = std::find(pickInfo.excludeIds.begin(), pickInfo.excludeIds.end(), entity.getId()) !=
+								pickInfo.excludeIds.end();
+
+		tvg::Paint* paint = nullptr;
+		if (auto* sceneComponent = entity.tryGetComponent<SceneComponent>())
 		{
-			tvg::Scene* rawScene = static_cast<tvg::Scene*>(paint);
-			core::Scene* scene = Scene::FindScene(rawScene);
-			if (scene == nullptr)
-				return false;
+			if (isExcluded)
+				continue;
 
+			bool isChildHit = false;
+			pickInfo.currentSelectedScene = sceneComponent->scene;
+			if (Pick(pickInfo, point, sceneComponent->scene, isChildHit))
+				return true;
 			pickInfo.currentSelectedScene = scene;
+			if (!isChildHit)
+				continue;
+			paint = sceneComponent->scene->getScene();
+		}
+		else
+		{
+			std::array<Vec2, 4> obb;
+			if (!GetObb(entity, obb) || !IsInner(obb, point) || !IsHit(entity, point))
+				continue;
+			if (isExcluded)
 			{
-				for (auto* p : rawScene->paints())
-				{
-					if (Pick(pickInfo, point, p, depth + 1))
-					{
-						return true;
-					}
-				}
+				isHit = true;
+				continue;
 			}
+			paint = entity.getComponent<ShapeComponent>().shape;
 		}
-		if (isCurrentSelected)
-			return false;
+
+		isHit = true;
+		if (pickInfo.currentSelectedPaint == paint)
+			continue;
+		pickInfo.currentSelectedScene = scene;
 		pickInfo.currentSelectedPaint = paint;
 		return true;
 	}
@@ -108,22 +228,11 @@ static void SetPickInfoType(PickInfo& pickInfo)
 	}
 }
 
-template <typename T>
-static bool Pick(T* canvasOrScene, PickInfo& pickInfo, const Vec2& point)
-{
-	auto& paints = canvasOrScene->paints();
-	bool isPicked = false;
-	for (auto& paint : paints)
-	{
-		isPicked |= Pick(pickInfo, point, paint, 0);
-	}
-	SetPickInfoType(pickInfo);
-	return isPicked;
-}
-template <>
-static bool Pick<tvg::Scene>(tvg::Scene* scene, PickInfo& pickInfo, const Vec2& point)
+static bool Pick(Scene* scene, PickInfo& pickInfo, const Vec2& point)
 {
-	auto ret = Pick(pickInfo, point, scene, 0);
+	pickInfo.currentSelectedScene = scene;
+	bool isHit = false;
+	auto ret = Pick(pickInfo, point, scene, isHit);
 	SetPickInfoType(pickInfo);
 	return ret;
 }
@@ -17,6 +17,7 @@ using Size = Vec2;
 struct CommonSetting
 {
 	inline static const Vec3 Color_DefaultHoverOutline{200.0f, 100.0f, 50.0f};
+	inline static const Vec3 Color_DefaultMarqueeOutline{63.0f, 127.0f, 255.0f};
 	inline static const Vec3 Color_DefaultControlBoxOutline{255.0f, 127.0f, 63.0f};
 	inline static const Vec3 Color_DefaultControlBoxInner{250.0f, 250.0f, 255.0f};
 	inline static const Vec3 Color_DefaultActiveFillStrokeEllipse{250.0f, 180.0f, 130.0f};
@@ -34,6 +35,15 @@ struct CommonSetting
 
 	inline static const float Threshold_AddPathModeChangeCurve{200.0f};
 	inline static const float Threshold_AddPathLayer{0.5f};
+
+	// pen paths with at least this many points are simplified when the stroke ends
+	inline static int Count_PathSimplifyMinPoint{64};
+	inline static float Threshold_PathSimplifyTolerance{0.5f};
+
+	// strokes thinner than this (in canvas pixels) are still picked within it
+	inline static float Threshold_PickStroke{3.0f};
+	// a drag from empty space becomes a marquee selection once it is this long (in canvas pixels)
+	inline static float Threshold_MarqueeStart{3.0f};
 };
 
 }	 // namespace core
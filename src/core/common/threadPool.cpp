@@ -0,0 +1,98 @@
+#include "threadPool.h"
+
+#include <algorithm>
+
+namespace core
+{
+
+ThreadPool::ThreadPool()
+{
+#ifndef __EMSCRIPTEN__
+	const size_t hardware = std::thread::hardware_concurrency();
+	const size_t count = hardware > 1 ? hardware - 1 : 0;
+	for (size_t i = 0; i < count; i++)
+	{
+		mWorkers.emplace_back(&ThreadPool::run, this);
+	}
+#endif
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mIsStop = true;
+	}
+	mWake.notify_all();
+	for (auto& worker : mWorkers)
+	{
+		worker.join();
+	}
+}
+
+void ThreadPool::parallelFor(size_t count, size_t chunkSize, const RangeFunc& func)
+{
+	chunkSize = std::max<size_t>(chunkSize, 1);
+	if (count == 0)
+		return;
+
+	if (mWorkers.empty() || count <= chunkSize)
+	{
+		func(0, count);
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		rJob = &func;
+		mCount = count;
+		mChunkSize = chunkSize;
+		mChunkCount = (count + chunkSize - 1) / chunkSize;
+		mNextChunk = 0;
+		mGeneration++;
+	}
+	mWake.notify_all();
+
+	work();
+
+	// every claimed chunk is finished by an active worker, so idle workers mean the job is done
+	std::unique_lock<std::mutex> lock(mMutex);
+	mIdle.wait(lock, [this]() { return mActiveWorkers == 0; });
+	rJob = nullptr;
+}
+
+void ThreadPool::run()
+{
+	uint64_t generation = 0;
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(mMutex);
+			mWake.wait(lock, [&]() { return mIsStop || (rJob != nullptr && generation != mGeneration); });
+			if (mIsStop)
+				return;
+			generation = mGeneration;
+			mActiveWorkers++;
+		}
+
+		work();
+
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			mActiveWorkers--;
+		}
+		mIdle.notify_one();
+	}
+}
+
+void ThreadPool::work()
+{
+	for (size_t chunk = mNextChunk.fetch_add(1); chunk < mChunkCount; chunk = mNextChunk.fetch_add(1))
+	{
+		const size_t begin = chunk * mChunkSize;
+		const size_t end = std::min(begin + mChunkSize, mCount);
+		(*rJob)(begin, end);
+	}
+}
+
+}	 // namespace core
@@ -0,0 +1,60 @@
+#ifndef _CORE_COMMON_THREAD_POOL_H_
+#define _CORE_COMMON_THREAD_POOL_H_
+
+#include "singleInstance.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace core
+{
+
+class ThreadPool : public SingleInstance<ThreadPool>
+{
+	friend class SingleInstance<ThreadPool>;
+
+public:
+	using RangeFunc = std::function<void(size_t begin, size_t end)>;
+
+	~ThreadPool();
+
+	size_t workerCount() const
+	{
+		return mWorkers.size();
+	}
+
+	// splits [0, count) into chunks of chunkSize and runs them on the workers and the calling thread.
+	// returns when every chunk is done. small ranges (or no workers, e.g. wasm) run inline.
+	void parallelFor(size_t count, size_t chunkSize, const RangeFunc& func);
+
+private:
+	ThreadPool();
+
+	void run();
+	void work();
+
+private:
+	std::vector<std::thread> mWorkers;
+	std::mutex mMutex;
+	std::condition_variable mWake;
+	std::condition_variable mIdle;
+
+	// current job, written under mMutex while no worker is active
+	const RangeFunc* rJob{nullptr};
+	size_t mCount{0};
+	size_t mChunkSize{1};
+	size_t mChunkCount{0};
+	std::atomic<size_t> mNextChunk{0};
+
+	uint64_t mGeneration{0};
+	size_t mActiveWorkers{0};
+	bool mIsStop{false};
+};
+
+}	 // namespace core
+
+#endif
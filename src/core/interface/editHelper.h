@@ -38,6 +38,7 @@ Edit_Result SetProp(ENTITY_ID id,
 
 	auto* p = static_cast<PathT*>(base);
 	p->*member = value;
+	p->markChanged();
 
 	if (ShouldAddKeyframe())
 	{
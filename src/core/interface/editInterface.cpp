@@ -3,6 +3,7 @@
 #include "scene/scene.h"
 #include "scene/component/components.h"
 #include "scene/component/uiComponents.h"
+#include "scene/component/pathSimplify.h"
 #include "canvas/animationCreatorCanvas.h"
 #include "canvas/animationCreatorInputController.h"
 #include "selection/selectionManager.h"
@@ -16,6 +17,38 @@ using namespace core;
 CANVAS_ptr gCurrentCanvas{nullptr};
 AnimationCreatorCanvas* gCurrentAnimCanvas{nullptr};
 
+template <typename T, typename ToValue>
+static Edit_Result MergeKeyframes(Keyframes<T>& track, const Edit_Keyframe* keys, int count, ToValue toValue)
+{
+	std::vector<typename Keyframes<T>::KeyframeDesc> converted;
+	converted.reserve(static_cast<size_t>(count));
+	for (int i = 0; i < count; i++)
+	{
+		const auto& key = keys[i];
+		converted.push_back({.frame = static_cast<uint32_t>(key.frame),
+							 .value = toValue(key.value),
+							 .inTangent = Vec2{key.inTangent[0], key.inTangent[1]},
+							 .outTangent = Vec2{key.outTangent[0], key.outTangent[1]}});
+	}
+	return track.merge(converted.data(), converted.size()) ? EDIT_RESULT_SUCCESS : EDIT_RESULT_FAIL;
+}
+
+// keys must be on frames >= 0 in strictly increasing order, checked before the entity is touched
+static bool IsValidKeys(const Edit_Keyframe* keys, int count)
+{
+	for (int i = 0; i < count; i++)
+	{
+		if (keys[i].frame < 0 || (i > 0 && keys[i - 1].frame >= keys[i].frame))
+			return false;
+	}
+	return true;
+}
+
+static Edit_ComponentMemory ToEdit(const ComponentMemory& memory)
+{
+	return Edit_ComponentMemory{static_cast<int>(memory.count), static_cast<unsigned long long>(memory.bytes)};
+}
+
 #ifdef __cplusplus
 extern "C"
 {
@@ -88,6 +121,19 @@ extern "C"
 		}
 	}
 
+	EDIT_API void SetBakeQuantize(CANVAS_ptr canvas, bool isQuantize)
+	{
+		if (canvas)
+		{
+			auto* rawcanvas = static_cast<CanvasWrapper*>(canvas);
+			if (rawcanvas->type() == CanvasType::AnimationCreator)
+			{
+				// the scenes compare it with the flag of their last bake and bake again on the next update
+				static_cast<AnimationCreatorCanvas*>(canvas)->mAnimator->mIsQuantizeBake = isQuantize;
+			}
+		}
+	}
+
 	EDIT_API ENTITY_ID CreateRectPathEntity(SCENE_ID id, float minX, float minY, float w, float h)
 	{
 		auto* scene = FindScene(id);
@@ -126,6 +172,51 @@ extern "C"
 		return entity.getComponent<IDComponent>().id;
 	}
 
+	EDIT_API int CreatePathEntities(SCENE_ID id, const Edit_ShapeDesc* descs, int count, ENTITY_ID* outIds)
+	{
+		auto* scene = FindScene(id);
+		if (scene == nullptr || descs == nullptr || count <= 0)
+			return 0;
+
+		std::vector<LayerDescriptor> layers(count);
+		for (int i = 0; i < count; i++)
+		{
+			const auto& desc = descs[i];
+			auto& layer = layers[i];
+			switch (desc.type)
+			{
+				case EDIT_SHAPE_RECT:
+					layer.type = IPath::Type::Rect;
+					break;
+				case EDIT_SHAPE_ELLIPSE:
+					layer.type = IPath::Type::Ellipse;
+					break;
+				case EDIT_SHAPE_POLYGON:
+					layer.type = IPath::Type::Polygon;
+					break;
+				case EDIT_SHAPE_STAR:
+					layer.type = IPath::Type::Star;
+					break;
+				default:
+					// nothing is created, so the ids written to outIds never belong to a partial batch
+					return 0;
+			}
+			layer.minXy = Vec2{desc.minX, desc.minY};
+			layer.wh = Vec2{desc.w, desc.h};
+			layer.hasStroke = desc.hasStroke;
+		}
+
+		auto entities = scene->createLayers(layers.data(), layers.size());
+		if (outIds)
+		{
+			for (size_t i = 0; i < entities.size(); i++)
+			{
+				outIds[i] = entities[i].getId();
+			}
+		}
+		return static_cast<int>(entities.size());
+	}
+
 	EDIT_API Edit_Result UpdateEntityTransformCurrentFrame(ENTITY_ID id, Edit_Transform* transform, bool isEnd)
 	{
 		auto entity = Scene::FindEntity(id);
@@ -273,6 +364,8 @@ extern "C"
 			auto& sourcePath = sourcePathList.paths;
 			sourcePath.erase(sourcePathList.paths.begin() + pathIndex);
 			targetPathList.paths.push_back(std::move(path));
+			sourcePathList.constant = ConstantRange{};
+			targetPathList.constant = ConstantRange{};
 
 			sourceEntity.setDirty(Dirty::Type::Path);
 			targetEntity.setDirty(Dirty::Type::Path);
@@ -556,6 +649,7 @@ extern "C"
 			.type = static_cast<PathPoint::Command>(pathPoint->type)};
 
 		path->path.push_back(p);
+		path->markChanged();
 		entity.setDirty(Dirty::Type::Path);
 	}
 
@@ -591,10 +685,127 @@ extern "C"
 		p.deltaLeftControlPosition = {pathPoint->leftControlRelPosition[0], pathPoint->leftControlRelPosition[1]};
 		p.deltaRightControlPosition = {pathPoint->rightControlRelPosition[0], pathPoint->rightControlRelPosition[1]};
 		p.type = static_cast<PathPoint::Command>(pathPoint->type);
+		path->markChanged();
 
 		entity.setDirty(Dirty::Type::Path);
 	}
 
+	EDIT_API Edit_Result SimplifyPath(ENTITY_ID id, int pathIndex, float tolerance, Edit_SimplifyResult* outResult)
+	{
+		auto entity = Scene::FindEntity(id);
+		if (entity.isNull())
+		{
+			return EDIT_RESULT_INVALID_ENTITY;
+		}
+
+		IPath* base = nullptr;
+		if (!FetchPath(entity, pathIndex, base))
+		{
+			return EDIT_RESULT_INVALID_INDEX;
+		}
+		if (base->type() != IPath::Type::Path)
+		{
+			return EDIT_RESULT_TYPE_MISMATCH;
+		}
+
+		auto result = core::SimplifyPath(*static_cast<RawPath*>(base), tolerance);
+		if (outResult)
+		{
+			outResult->inputPointCount = static_cast<int>(result.inputPointCount);
+			outResult->outputPointCount = static_cast<int>(result.outputPointCount);
+			outResult->ratio = result.ratio();
+			outResult->maxError = result.maxError;
+		}
+		if (!result.isSimplified)
+		{
+			return EDIT_RESULT_FAIL;
+		}
+
+		entity.setDirty(Dirty::Type::Path);
+		return EDIT_RESULT_SUCCESS;
+	}
+
+	EDIT_API Edit_Result AddKeyframes(ENTITY_ID id, Edit_KeyframeTarget target, const Edit_Keyframe* keys, int count)
+	{
+		auto entity = Scene::FindEntity(id);
+		if (entity.isNull())
+			return EDIT_RESULT_INVALID_ENTITY;
+		if (keys == nullptr || count <= 0 || !IsValidKeys(keys, count))
+			return EDIT_RESULT_FAIL;
+
+		auto toFloat = [](const float* v) { return v[0]; };
+		auto toVec2 = [](const float* v) { return Vec2{v[0], v[1]}; };
+		auto toVec3 = [](const float* v) { return Vec3{v[0], v[1], v[2]}; };
+
+		switch (target)
+		{
+			case EDIT_KEYFRAME_TARGET_POSITION:
+			case EDIT_KEYFRAME_TARGET_SCALE:
+			case EDIT_KEYFRAME_TARGET_ROTATION:
+			{
+				AddTransformKeyframe(entity);
+				auto& trk = entity.getComponent<TransformKeyframeComponent>();
+				Edit_Result result = EDIT_RESULT_FAIL;
+				if (target == EDIT_KEYFRAME_TARGET_POSITION)
+					result = MergeKeyframes(trk.positionKeyframes, keys, count, toVec2);
+				else if (target == EDIT_KEYFRAME_TARGET_SCALE)
+					result = MergeKeyframes(trk.scaleKeyframes, keys, count, toVec2);
+				else
+					result = MergeKeyframes(trk.rotationKeyframes, keys, count, toFloat);
+				if (result == EDIT_RESULT_SUCCESS)
+					entity.setDirty(Dirty::Type::Transform);
+				return result;
+			}
+			case EDIT_KEYFRAME_TARGET_FILL_COLOR:
+			case EDIT_KEYFRAME_TARGET_FILL_ALPHA:
+			{
+				if (!entity.hasComponent<SolidFillComponent>())
+					return EDIT_RESULT_INVALID_ENTITY;
+				auto& solidFill = entity.getComponent<SolidFillComponent>();
+				auto result = target == EDIT_KEYFRAME_TARGET_FILL_COLOR
+								  ? MergeKeyframes(solidFill.colorKeyframe, keys, count, toVec3)
+								  : MergeKeyframes(solidFill.alphaKeyframe, keys, count, toFloat);
+				if (result == EDIT_RESULT_SUCCESS)
+					entity.setDirty(Dirty::Type::Fill);
+				return result;
+			}
+			case EDIT_KEYFRAME_TARGET_STROKE_COLOR:
+			case EDIT_KEYFRAME_TARGET_STROKE_WIDTH:
+			case EDIT_KEYFRAME_TARGET_STROKE_ALPHA:
+			{
+				if (!entity.hasComponent<StrokeComponent>())
+					return EDIT_RESULT_INVALID_ENTITY;
+				auto& stroke = entity.getComponent<StrokeComponent>();
+				Edit_Result result = EDIT_RESULT_FAIL;
+				if (target == EDIT_KEYFRAME_TARGET_STROKE_COLOR)
+					result = MergeKeyframes(stroke.colorKeyframe, keys, count, toVec3);
+				else if (target == EDIT_KEYFRAME_TARGET_STROKE_WIDTH)
+					result = MergeKeyframes(stroke.widthKeyframe, keys, count, toFloat);
+				else
+					result = MergeKeyframes(stroke.alphaKeyframe, keys, count, toFloat);
+				if (result == EDIT_RESULT_SUCCESS)
+					entity.setDirty(Dirty::Type::Stroke);
+				return result;
+			}
+		}
+		return EDIT_RESULT_FAIL;
+	}
+
+	EDIT_API Edit_Result GetSceneMemoryReport(SCENE_ID id, Edit_MemoryReport* outReport)
+	{
+		auto* scene = FindScene(id);
+		if (scene == nullptr || outReport == nullptr)
+			return EDIT_RESULT_FAIL;
+
+		const auto report = scene->memoryReport();
+		outReport->transformKeyframe = ToEdit(report.transformKeyframe);
+		outReport->pathList = ToEdit(report.pathList);
+		outReport->solidFill = ToEdit(report.solidFill);
+		outReport->stroke = ToEdit(report.stroke);
+		outReport->bake = ToEdit(report.bake);
+		return EDIT_RESULT_SUCCESS;
+	}
+
 #ifdef __cplusplus
 }	 // extern "C"
 #endif
@@ -8,6 +8,7 @@ extern "C"
 {
 #endif
 
+	// generational handle of an entity (core::EntityID), 0 is invalid. a handle of a destroyed entity stays invalid
 	typedef int ENTITY_ID;
 	typedef int SCENE_ID;
 	typedef int CANVAS_ID;
@@ -60,6 +61,68 @@ extern "C"
 		EDIT_MODE_EDIT_PATH = 7,
 	} Edit_Mode;
 
+	typedef enum
+	{
+		EDIT_SHAPE_RECT = 0,
+		EDIT_SHAPE_ELLIPSE = 1,
+		EDIT_SHAPE_POLYGON = 2,
+		EDIT_SHAPE_STAR = 3
+	} Edit_ShapeType;
+
+	typedef struct
+	{
+		Edit_ShapeType type;
+		float minX;
+		float minY;
+		float w;
+		float h;
+		bool hasStroke;
+	} Edit_ShapeDesc;
+
+	typedef struct
+	{
+		int inputPointCount;
+		int outputPointCount;
+		float ratio;	   // outputPointCount / inputPointCount
+		float maxError;	   // estimated largest distance from the original outline, in path-local units
+	} Edit_SimplifyResult;
+
+	typedef enum
+	{
+		EDIT_KEYFRAME_TARGET_POSITION = 0,	  // value[0..1]
+		EDIT_KEYFRAME_TARGET_SCALE = 1,		  // value[0..1]
+		EDIT_KEYFRAME_TARGET_ROTATION = 2,	  // value[0]
+		EDIT_KEYFRAME_TARGET_FILL_COLOR = 3,	  // value[0..2]
+		EDIT_KEYFRAME_TARGET_FILL_ALPHA = 4,	  // value[0]
+		EDIT_KEYFRAME_TARGET_STROKE_COLOR = 5,	  // value[0..2]
+		EDIT_KEYFRAME_TARGET_STROKE_WIDTH = 6,	  // value[0]
+		EDIT_KEYFRAME_TARGET_STROKE_ALPHA = 7	  // value[0]
+	} Edit_KeyframeTarget;
+
+	typedef struct
+	{
+		int frame;
+		float value[3];
+		float inTangent[2];
+		float outTangent[2];
+	} Edit_Keyframe;
+
+	typedef struct
+	{
+		int count;
+		unsigned long long bytes;
+	} Edit_ComponentMemory;
+
+	// inline size and allocated bytes (keyframe tracks, path points) of the animated components of a scene
+	typedef struct
+	{
+		Edit_ComponentMemory transformKeyframe;
+		Edit_ComponentMemory pathList;
+		Edit_ComponentMemory solidFill;
+		Edit_ComponentMemory stroke;
+		Edit_ComponentMemory bake;	  // baked samples of the components above
+	} Edit_MemoryReport;
+
 	/**
 	 * temp code
 	 */
@@ -68,6 +131,8 @@ extern "C"
 	EDIT_API Edit_Mode GetCurrentEditMode(CANVAS_ptr canvas);
 	EDIT_API void SetEditMode(CANVAS_ptr canvas, Edit_Mode editMode);
 	EDIT_API void SetPathEditMode(CANVAS_ptr canvas, ENTITY_ID id, int pathIdx);
+	// stores the baked keyframe samples of the canvas as 16 bits per channel instead of full values
+	EDIT_API void SetBakeQuantize(CANVAS_ptr canvas, bool isQuantize);
 
 	/***
 	 * todo: UNDO/REDO
@@ -76,6 +141,9 @@ extern "C"
 	EDIT_API ENTITY_ID CreateElipsePathEntity(SCENE_ID id, float minX, float minY, float w, float h);
 	EDIT_API ENTITY_ID CreatePolygonPathEntity(SCENE_ID id, float minX, float minY, float w, float h);
 	EDIT_API ENTITY_ID CreateStarPathEntity(SCENE_ID id, float minX, float minY, float w, float h);
+	// creates count entities in one batch, writes their ids to outIds (if not null). returns the created count,
+	// 0 (nothing created) if any desc has an unknown type
+	EDIT_API int CreatePathEntities(SCENE_ID id, const Edit_ShapeDesc* descs, int count, ENTITY_ID* outIds);
 
 	EDIT_API Edit_Result UpdateEntityTransformCurrentFrame(ENTITY_ID id, Edit_Transform* transform, bool isEnd);
 	EDIT_API Edit_Result UpdateEntityRotationCurrentFrame(ENTITY_ID id, float x, bool isEnd);
@@ -182,6 +250,16 @@ extern "C"
 													   bool isAddMode,
 													   int pointIndex);
 
+	// replaces the points of a path with fewer cubic segments within tolerance (path-local units).
+	// animated paths and paths with several sub-paths are left unchanged (EDIT_RESULT_FAIL)
+	EDIT_API Edit_Result SimplifyPath(ENTITY_ID id, int pathIndex, float tolerance, Edit_SimplifyResult* outResult);
+
+	// merges keys sorted by strictly increasing frame into one track in a single pass (bulk import).
+	// keys on frames that already have a key replace them. unsorted keys or negative frames give EDIT_RESULT_FAIL
+	EDIT_API Edit_Result AddKeyframes(ENTITY_ID id, Edit_KeyframeTarget target, const Edit_Keyframe* keys, int count);
+
+	EDIT_API Edit_Result GetSceneMemoryReport(SCENE_ID id, Edit_MemoryReport* outReport);
+
 #ifdef __cplusplus
 }	 // extern "C"
 #endif
@@ -12,6 +12,8 @@
 #include <memory>
 #include <vector>
 #include <algorithm>
+#include <array>
+#include <limits>
 
 #include <thorvg.h>
 
@@ -55,6 +57,16 @@ struct ShapeComponent
 {
 	Entity owner;
 	tvg::Shape* shape{nullptr};
+
+	// sub-path segments last submitted to tvg (Update(ShapeComponent&, PathListComponent&, bool)).
+	// held, not copied: bounds and outline read them, and a shared segment is not duplicated per shape
+	struct AppliedSegment
+	{
+		std::shared_ptr<const PathSegment> segment;
+		uint32_t revision{0};
+	};
+	std::vector<AppliedSegment> segments;
+	uint32_t pathRevision{0};	 // bumped on every path rebuild, checked by BoundsComponent
 };
 
 struct SceneComponent
@@ -133,10 +145,15 @@ static void applyRotateR(tvg::Matrix* m, float degree)
 	m->e22 = -s * e21 + c * e22;
 }
 
+static inline float determinant(const tvg::Matrix* m)
+{
+	return m->e11 * (m->e22 * m->e33 - m->e32 * m->e23) - m->e12 * (m->e21 * m->e33 - m->e23 * m->e31) +
+		   m->e13 * (m->e21 * m->e32 - m->e22 * m->e31);
+}
+
 static bool inverse(const tvg::Matrix* m, tvg::Matrix* out)
 {
-	auto det = m->e11 * (m->e22 * m->e33 - m->e32 * m->e23) - m->e12 * (m->e21 * m->e33 - m->e23 * m->e31) +
-			   m->e13 * (m->e21 * m->e32 - m->e22 * m->e31);
+	auto det = determinant(m);
 
 	auto invDet = 1.0f / det;
 	if (std::isinf(invDet))
@@ -176,9 +193,8 @@ struct TransformComponent
 	Vec2 localPosition{0.0f, 0.0f};	   // center of layer
 	Vec2 scale{1.0f, 1.0f};
 	float rotation{};
-	tvg::Matrix localTransform;
+	tvg::Matrix localTransform = identity();
 
-	// todo: parent transform
 	void update()
 	{
 		localTransform = identity();
@@ -190,48 +206,84 @@ struct TransformComponent
 	}
 };
 
+// world transform of an entity, kept in a hierarchy (parent -> children) so a change only
+// recomputes the subtree below it. see UpdateWorldTransform / Scene::updateWorldTransforms
 struct WorldTransformComponent
 {
 	Entity owner;
 	Entity parent;
-	const TransformComponent* localTransform;
-	const WorldTransformComponent* parentTransform = nullptr;
+	std::vector<Entity> children;
+	size_t childIndex{0};	 // position in parent's children
 	tvg::Matrix worldTransform;
-	tvg::Matrix inverseWorldTransform;
 	Vec2 worldPosition;
+	bool isDirty{false};	// queued for Scene::updateWorldTransforms
+	uint32_t revision{0};	 // bumped whenever worldTransform changes
 
 	WorldTransformComponent(Entity owner, Entity parent) : owner(owner), parent(parent)
 	{
 		identity(&worldTransform);
-		identity(&inverseWorldTransform);
-		update();
+		identity(&mInverseWorldTransform);
 	}
 
-	void update()
+	// computed on first use after the world transform changes (picking, gizmos)
+	const tvg::Matrix& inverseWorldTransform() const
 	{
-		parentTransform = nullptr;
-		localTransform = &owner.getComponent<TransformComponent>();
-		if (!parent.isNull())
+		if (mIsInverseDirty)
 		{
-			parentTransform = &parent.getComponent<WorldTransformComponent>();
-		}
-		auto world = identity();
-		if (parentTransform)
-			world = update(parentTransform->worldTransform);
-		else
-			world = update(identity());
-
-		if (inverse(&world, &inverseWorldTransform))
-		{
-			worldTransform = world;
-			worldPosition = Vec2{0.0f, 0.0f} * worldTransform;
+			inverse(&worldTransform, &mInverseWorldTransform);
+			mIsInverseDirty = false;
 		}
+		return mInverseWorldTransform;
 	}
 
-	tvg::Matrix update(tvg::Matrix parentTransform)
+	void update(const tvg::Matrix& parentTransform, const TransformComponent& localTransform)
 	{
-		return parentTransform * localTransform->localTransform;
+		isDirty = false;
+
+		// a non-invertible world (e.g. zero scale) keeps the last valid one
+		auto world = parentTransform * localTransform.localTransform;
+		if (std::isinf(1.0f / determinant(&world)))
+			return;
+
+		worldTransform = world;
+		worldPosition = Vec2{0.0f, 0.0f} * worldTransform;
+		mIsInverseDirty = true;
+		revision++;
 	}
+
+private:
+	mutable tvg::Matrix mInverseWorldTransform;
+	mutable bool mIsInverseDirty{false};
+};
+
+// bounds of a shape entity, refreshed by Update(BoundsComponent&, ...) only when the path, stroke width or
+// world transform changed since the last call. picking, hover and the bbox gizmo read these instead of
+// tvg::Paint::bounds, which walks the whole path every time
+struct BoundsComponent
+{
+	Vec2 localMin{0.0f, 0.0f};	  // aabb of the path points (control points included) and half the stroke width
+	Vec2 localMax{0.0f, 0.0f};
+	std::array<Vec2, 4> worldObb;	 // local aabb corners in world space, same order as tvg::Paint::bounds
+	Vec2 worldMin{0.0f, 0.0f};
+	Vec2 worldMax{0.0f, 0.0f};
+	bool isEmpty{true};
+
+	uint32_t pathRevision{UINT32_MAX};
+	uint32_t worldRevision{UINT32_MAX};
+	float strokeWidth{-1.0f};
+};
+
+// the path of a shape flattened to polylines in local space, for exact picking.
+// built on first use and rebuilt only when the path revision changes
+struct OutlineComponent
+{
+	static constexpr float Size_FlattenStep = 4.0f;	   // approximate length of a flattened curve segment
+	static constexpr int Count_MaxCurveSegment = 64;
+
+	std::vector<Vec2> points;
+	std::vector<uint32_t> contourEnds;	  // end (exclusive) of each contour in points
+	std::vector<uint8_t> isClosed;		  // per contour
+	uint32_t pathRevision{UINT32_MAX};
 };
 
 struct TransformKeyframeComponent
@@ -239,6 +291,7 @@ struct TransformKeyframeComponent
 	VectorKeyFrame positionKeyframes;
 	VectorKeyFrame scaleKeyframes;
 	FloatKeyFrame rotationKeyframes;
+	ConstantRange constant;	   // cached during playback, see Scene::onUpdate
 
 	bool update(float frameNo, TransformComponent& transform)
 	{
@@ -248,6 +301,29 @@ struct TransformKeyframeComponent
 		UPDATE_KEYFRAME(rotationKeyframes, transform.rotation, frameNo, changed);
 		return changed;
 	}
+	void bake(uint32_t from, uint32_t to, BakeBudget& budget)
+	{
+		positionKeyframes.bake(from, to, budget);
+		scaleKeyframes.bake(from, to, budget);
+		rotationKeyframes.bake(from, to, budget);
+	}
+	ConstantRange constantRange(float frameNo)
+	{
+		auto range = positionKeyframes.constantRange(frameNo);
+		range &= scaleKeyframes.constantRange(frameNo);
+		range &= rotationKeyframes.constantRange(frameNo);
+		return range;
+	}
+	size_t memoryUsage() const
+	{
+		return sizeof(*this) + positionKeyframes.memoryUsage() + scaleKeyframes.memoryUsage() +
+			   rotationKeyframes.memoryUsage();
+	}
+	size_t bakeMemoryUsage() const
+	{
+		return positionKeyframes.bakeMemoryUsage() + scaleKeyframes.bakeMemoryUsage() +
+			   rotationKeyframes.bakeMemoryUsage();
+	}
 };
 
 struct SolidFillComponent
@@ -258,6 +334,13 @@ struct SolidFillComponent
 
 	ColorKeyFrame colorKeyframe;
 	FloatKeyFrame alphaKeyframe;
+	ConstantRange constant;	   // cached during playback, see Scene::onUpdate
+
+	// last values set on the tvg shape, Update(ShapeComponent&, SolidFillComponent&) skips unchanged ones
+	uint32_t appliedRgba{0};
+	tvg::FillRule appliedRule{tvg::FillRule::NonZero};
+	bool isColorApplied{false};
+	bool isRuleApplied{false};
 
 	bool update(float frameNo)
 	{
@@ -266,6 +349,25 @@ struct SolidFillComponent
 		UPDATE_KEYFRAME(alphaKeyframe, alpha, frameNo, changed);
 		return changed;
 	}
+	void bake(uint32_t from, uint32_t to, BakeBudget& budget)
+	{
+		colorKeyframe.bake(from, to, budget);
+		alphaKeyframe.bake(from, to, budget);
+	}
+	ConstantRange constantRange(float frameNo)
+	{
+		auto range = colorKeyframe.constantRange(frameNo);
+		range &= alphaKeyframe.constantRange(frameNo);
+		return range;
+	}
+	size_t memoryUsage() const
+	{
+		return sizeof(*this) + colorKeyframe.memoryUsage() + alphaKeyframe.memoryUsage();
+	}
+	size_t bakeMemoryUsage() const
+	{
+		return colorKeyframe.bakeMemoryUsage() + alphaKeyframe.bakeMemoryUsage();
+	}
 };
 
 struct StrokeComponent
@@ -278,6 +380,14 @@ struct StrokeComponent
 	ColorKeyFrame colorKeyframe;
 	FloatKeyFrame widthKeyframe;
 	FloatKeyFrame alphaKeyframe;
+	ConstantRange constant;	   // cached during playback, see Scene::onUpdate
+
+	// last values set on the tvg shape, Update(ShapeComponent&, StrokeComponent&) skips unchanged ones
+	uint32_t appliedRgba{0};
+	float appliedWidth{0.0f};
+	bool isColorApplied{false};
+	bool isWidthApplied{false};
+	bool isStyleApplied{false};	   // order, join and cap never change
 
 	bool update(float frameNo)
 	{
@@ -287,6 +397,28 @@ struct StrokeComponent
 		UPDATE_KEYFRAME(widthKeyframe, width, frameNo, changed);
 		return changed;
 	}
+	void bake(uint32_t from, uint32_t to, BakeBudget& budget)
+	{
+		colorKeyframe.bake(from, to, budget);
+		alphaKeyframe.bake(from, to, budget);
+		widthKeyframe.bake(from, to, budget);
+	}
+	ConstantRange constantRange(float frameNo)
+	{
+		auto range = colorKeyframe.constantRange(frameNo);
+		range &= alphaKeyframe.constantRange(frameNo);
+		range &= widthKeyframe.constantRange(frameNo);
+		return range;
+	}
+	size_t memoryUsage() const
+	{
+		return sizeof(*this) + colorKeyframe.memoryUsage() + alphaKeyframe.memoryUsage() +
+			   widthKeyframe.memoryUsage();
+	}
+	size_t bakeMemoryUsage() const
+	{
+		return colorKeyframe.bakeMemoryUsage() + alphaKeyframe.bakeMemoryUsage() + widthKeyframe.bakeMemoryUsage();
+	}
 };
 
 }	 // namespace core
@@ -309,150 +441,432 @@ static void Update(ShapeComponent& shape, TransformComponent& transform)
 	shape.shape->transform(transform.localTransform);
 }
 
-static void Update(ShapeComponent& shape, RawPath& path)
+static void Build(PathSegment& segment, RawPath& path)
 {
-	if (!path.path.empty())
-	{
-		std::vector<tvg::PathCommand> types;
-		std::vector<tvg::Point> points;
+	auto& types = segment.commands;
+	auto& points = segment.points;
 
-		for (int i = 0; i < path.path.size(); i++)
+	for (int i = 0; i < path.path.size(); i++)
+	{
+		auto& p = path.path[i];
+		switch (p.type)
 		{
-			auto& p = path.path.at(i);
-			switch (p.type)
+			case PathPoint::Command::Close:
 			{
-				case PathPoint::Command::Close:
-				{
-					auto& left = path.path[i - 1];
-					auto& right = path.path[0];
-					if (left.type == PathPoint::Command::CubicTo)
-					{
-						auto leftP = left.localPosition + left.deltaRightControlPosition;
-						auto rightP = right.localPosition + right.deltaLeftControlPosition;
-						types.emplace_back(tvg::PathCommand::CubicTo);
-						points.push_back(tvg::Point{leftP.x, leftP.y});
-						points.push_back(tvg::Point{rightP.x, rightP.y});
-						points.push_back(tvg::Point{right.localPosition.x, right.localPosition.y});
-					}
-					else if (left.type == PathPoint::Command::LineTo)
-					{
-						types.emplace_back(tvg::PathCommand::LineTo);
-						points.push_back(tvg::Point{right.localPosition.x, right.localPosition.y});
-					}
-
-					types.emplace_back(tvg::PathCommand::Close);
-					break;
-				}
-				case PathPoint::Command::MoveTo:
-				{
-					types.emplace_back(tvg::PathCommand::MoveTo);
-					points.push_back(tvg::Point{p.localPosition.x, p.localPosition.y});
-					break;
-				}
-				case PathPoint::Command::CubicTo:
+				auto& left = path.path[i - 1];
+				auto& right = path.path[0];
+				if (left.type == PathPoint::Command::CubicTo)
 				{
-					assert(i != 0);
-
-					auto& left = path.path[i - 1];
 					auto leftP = left.localPosition + left.deltaRightControlPosition;
-					auto rightP = p.localPosition + p.deltaLeftControlPosition;
-
+					auto rightP = right.localPosition + right.deltaLeftControlPosition;
 					types.emplace_back(tvg::PathCommand::CubicTo);
 					points.push_back(tvg::Point{leftP.x, leftP.y});
 					points.push_back(tvg::Point{rightP.x, rightP.y});
-					points.push_back(tvg::Point{p.localPosition.x, p.localPosition.y});
-					break;
+					points.push_back(tvg::Point{right.localPosition.x, right.localPosition.y});
 				}
-				case PathPoint::Command::LineTo:
+				else if (left.type == PathPoint::Command::LineTo)
 				{
 					types.emplace_back(tvg::PathCommand::LineTo);
-					points.push_back(tvg::Point{p.localPosition.x, p.localPosition.y});
-					break;
+					points.push_back(tvg::Point{right.localPosition.x, right.localPosition.y});
 				}
+
+				types.emplace_back(tvg::PathCommand::Close);
+				break;
+			}
+			case PathPoint::Command::MoveTo:
+			{
+				types.emplace_back(tvg::PathCommand::MoveTo);
+				points.push_back(tvg::Point{p.localPosition.x, p.localPosition.y});
+				break;
+			}
+			case PathPoint::Command::CubicTo:
+			{
+				assert(i != 0);
+
+				auto& left = path.path[i - 1];
+				auto leftP = left.localPosition + left.deltaRightControlPosition;
+				auto rightP = p.localPosition + p.deltaLeftControlPosition;
+
+				types.emplace_back(tvg::PathCommand::CubicTo);
+				points.push_back(tvg::Point{leftP.x, leftP.y});
+				points.push_back(tvg::Point{rightP.x, rightP.y});
+				points.push_back(tvg::Point{p.localPosition.x, p.localPosition.y});
+				break;
+			}
+			case PathPoint::Command::LineTo:
+			{
+				types.emplace_back(tvg::PathCommand::LineTo);
+				points.push_back(tvg::Point{p.localPosition.x, p.localPosition.y});
+				break;
 			}
 		}
-		shape.shape->appendPath(types.data(), types.size(), points.data(), points.size());
 	}
 }
 
-static void Update(ShapeComponent& shape, StarPolygonPath& path)
+// closed outline through points already written to segment.points[first..], matching the RawPath conversion
+static void BuildClosedPolyline(PathSegment& segment, size_t first)
 {
-	const float start = -90.0f;
-	const float step = 360.0f / (path.points * 2.0f);
-	const int iterCount = 2 * path.points;
-
-	path.path.path.clear();
+	const size_t count = segment.points.size() - first;
+	if (count == 0)
+		return;
 
-	for (int i = 0; i < iterCount; ++i)
+	segment.commands.push_back(tvg::PathCommand::MoveTo);
+	if (count > 1)
 	{
-		const bool isOuter = (i % 2 == 0);
-		const float r = isOuter ? path.outerRadius : path.innerRadius;
-		const float degree = start + i * step;
+		segment.commands.insert(segment.commands.end(), count, tvg::PathCommand::LineTo);
+		segment.points.push_back(segment.points[first]);
+	}
+	segment.commands.push_back(tvg::PathCommand::Close);
+}
 
-		const float px = std::cos(ToRadian(degree)) * r;
-		const float py = std::sin(ToRadian(degree)) * r;
+static void Build(PathSegment& segment, StarPolygonPath& path)
+{
+	if (path.points <= 0)
+		return;
 
-		auto type = (i == 0 ? PathPoint::Command::MoveTo : PathPoint::Command::LineTo);
-		path.path.path.push_back({.localPosition{px, py}, .type = type});
+	const int count = 2 * path.points;
+	const auto& table = GetUnitCircleTable(count);
+	const float* tx = table.x.data();
+	const float* ty = table.y.data();
+
+	// outer and inner vertices alternate; the loop has no branches so it vectorizes
+	const size_t first = segment.points.size();
+	segment.points.resize(first + count);
+	tvg::Point* out = segment.points.data() + first;
+	const float outer = path.outerRadius;
+	const float inner = path.innerRadius;
+	for (int i = 0; i < count; i += 2)
+	{
+		out[i] = {tx[i] * outer, ty[i] * outer};
+		out[i + 1] = {tx[i + 1] * inner, ty[i + 1] * inner};
 	}
-	path.path.path.push_back({.type = PathPoint::Command::Close});
 
-	Update(shape, path.path);
+	BuildClosedPolyline(segment, first);
 }
 
-static void Update(ShapeComponent& shape, PolygonPath& path)
+static void Build(PathSegment& segment, PolygonPath& path)
 {
-	const float start = -90.0f;
-	const float step = 360.0f / path.points;
+	if (path.points <= 0)
+		return;
 
-	path.path.path.clear();
+	const int count = path.points;
+	const auto& table = GetUnitCircleTable(count);
+	const float* tx = table.x.data();
+	const float* ty = table.y.data();
 
-	for (int i = 0; i < path.points; ++i)
+	const size_t first = segment.points.size();
+	segment.points.resize(first + count);
+	tvg::Point* out = segment.points.data() + first;
+	const float r = path.outerRadius;
+	for (int i = 0; i < count; i++)
 	{
-		const bool isOuter = (i % 2 == 0);
-		const float r = path.outerRadius;
-		const float degree = start + i * step;
+		out[i] = {tx[i] * r, ty[i] * r};
+	}
 
-		const float px = std::cos(ToRadian(degree)) * r;
-		const float py = std::sin(ToRadian(degree)) * r;
-		auto type = (i == 0 ? PathPoint::Command::MoveTo : PathPoint::Command::LineTo);
+	BuildClosedPolyline(segment, first);
+}
 
-		path.path.path.push_back({.localPosition{px, py}, .type = type});
-	}
+// control point distance of a quarter circle cubic (tvg uses the same value)
+static constexpr float Kappa_Circle = 0.552284f;
+
+// same outline as tvg::Shape::appendCircle, generated here so it can be cached with the other segments
+static void Build(PathSegment& segment, EllipsePath& path)
+{
+	const float cx = path.position.x;
+	const float cy = path.position.y;
+	const float rx = path.scale.x * 0.5f;
+	const float ry = path.scale.y * 0.5f;
+	const float rxKappa = rx * Kappa_Circle;
+	const float ryKappa = ry * Kappa_Circle;
+
+	segment.commands.insert(segment.commands.end(),
+							{tvg::PathCommand::MoveTo, tvg::PathCommand::CubicTo, tvg::PathCommand::CubicTo,
+							 tvg::PathCommand::CubicTo, tvg::PathCommand::CubicTo, tvg::PathCommand::Close});
+	segment.points.insert(segment.points.end(), {{cx, cy - ry},
+												 {cx + rxKappa, cy - ry},
+												 {cx + rx, cy - ryKappa},
+												 {cx + rx, cy},
+												 {cx + rx, cy + ryKappa},
+												 {cx + rxKappa, cy + ry},
+												 {cx, cy + ry},
+												 {cx - rxKappa, cy + ry},
+												 {cx - rx, cy + ryKappa},
+												 {cx - rx, cy},
+												 {cx - rx, cy - ryKappa},
+												 {cx - rxKappa, cy - ry},
+												 {cx, cy - ry}});
+}
 
-	path.path.path.push_back({.type = PathPoint::Command::Close});
+// same outline as tvg::Shape::appendRect
+static void Build(PathSegment& segment, RectPath& path)
+{
+	const float w = path.scale.x;
+	const float h = path.scale.y;
+	const float x = path.position.x - w * 0.5f;
+	const float y = path.position.y - h * 0.5f;
+	const float hw = w * 0.5f;
+	const float hh = h * 0.5f;
+	const float rx = std::min(path.radius, hw);
+	const float ry = std::min(path.radius, hh);
+
+	auto& types = segment.commands;
+	auto& points = segment.points;
 
-	Update(shape, path.path);
+	if (rx == 0.0f && ry == 0.0f)
+	{
+		types.insert(types.end(), {tvg::PathCommand::MoveTo, tvg::PathCommand::LineTo, tvg::PathCommand::LineTo,
+								   tvg::PathCommand::LineTo, tvg::PathCommand::Close});
+		points.insert(points.end(), {{x, y}, {x + w, y}, {x + w, y + h}, {x, y + h}});
+	}
+	else if (rx == hw && ry == hh)
+	{
+		EllipsePath circle;
+		circle.position = path.position;
+		circle.scale = path.scale;
+		Build(segment, circle);
+	}
+	else
+	{
+		const float hrx = rx * Kappa_Circle;
+		const float hry = ry * Kappa_Circle;
+		types.insert(types.end(), {tvg::PathCommand::MoveTo, tvg::PathCommand::LineTo, tvg::PathCommand::CubicTo,
+								   tvg::PathCommand::LineTo, tvg::PathCommand::CubicTo, tvg::PathCommand::LineTo,
+								   tvg::PathCommand::CubicTo, tvg::PathCommand::LineTo, tvg::PathCommand::CubicTo,
+								   tvg::PathCommand::Close});
+		points.insert(points.end(), {{x + rx, y},
+									 {x + w - rx, y},
+									 {x + w - rx + hrx, y},
+									 {x + w, y + ry - hry},
+									 {x + w, y + ry},
+									 {x + w, y + h - ry},
+									 {x + w, y + h - ry + hry},
+									 {x + w - rx + hrx, y + h},
+									 {x + w - rx, y + h},
+									 {x + rx, y + h},
+									 {x + rx - hrx, y + h},
+									 {x, y + h - ry + hry},
+									 {x, y + h - ry},
+									 {x, y + ry},
+									 {x, y + ry - hry},
+									 {x + rx - hrx, y},
+									 {x + rx, y}});
+	}
 }
 
-static void Update(ShapeComponent& shape, EllipsePath& path)
+// rebuilds the tvg path from the segment of each sub-path. only sub-paths whose version changed are regenerated,
+// unless isRebuildAll is set (Entity::update, for points edited without markChanged), and tvg is left untouched
+// if every segment is still the applied one
+static void Update(ShapeComponent& shape, PathListComponent& pathList, bool isRebuildAll)
 {
-	shape.shape->appendCircle(path.position.x, path.position.y, path.scale.x * 0.5f, path.scale.y * 0.5f);
+	auto& paths = pathList.paths;
+	bool isSame = shape.segments.size() == paths.size();
+	for (size_t i = 0; i < paths.size(); i++)
+	{
+		const auto& segment = paths[i]->segment(isRebuildAll);
+		isSame = isSame && shape.segments[i].segment == segment && shape.segments[i].revision == segment->revision;
+	}
+	if (isSame)
+		return;
+
+	Reset(shape);
+	shape.segments.resize(paths.size());
+	for (size_t i = 0; i < paths.size(); i++)
+	{
+		// the segments are up to date, segment() only returns them
+		const auto& segment = paths[i]->segment();
+		shape.segments[i] = {segment, segment->revision};
+		if (!segment->commands.empty())
+		{
+			shape.shape->appendPath(segment->commands.data(), segment->commands.size(), segment->points.data(),
+									segment->points.size());
+		}
+	}
+	shape.pathRevision++;
 }
 
-static void Update(ShapeComponent& shape, RectPath& path)
+// the applied segments hold the points of the last path rebuild, so the local box does not touch tvg
+static void Update(BoundsComponent& bounds,
+				   const ShapeComponent& shape,
+				   const WorldTransformComponent& world,
+				   const StrokeComponent* stroke)
 {
-	const float x = path.position.x - path.scale.x * 0.5f;
-	const float y = path.position.y - path.scale.y * 0.5f;
-	shape.shape->appendRect(x, y, path.scale.x, path.scale.y, path.radius, path.radius);
+	const float strokeWidth = stroke ? stroke->width : 0.0f;
+	const bool isLocalChanged = bounds.pathRevision != shape.pathRevision || bounds.strokeWidth != strokeWidth;
+	if (!isLocalChanged && bounds.worldRevision == world.revision)
+		return;
+
+	if (isLocalChanged)
+	{
+		bounds.pathRevision = shape.pathRevision;
+		bounds.strokeWidth = strokeWidth;
+		bounds.isEmpty = true;
+
+		Vec2 minXy{std::numeric_limits<float>::max(), std::numeric_limits<float>::max()};
+		Vec2 maxXy{std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest()};
+		for (const auto& applied : shape.segments)
+		{
+			bounds.isEmpty = bounds.isEmpty && applied.segment->points.empty();
+			for (const auto& p : applied.segment->points)
+			{
+				minXy = Vec2{std::min(minXy.x, p.x), std::min(minXy.y, p.y)};
+				maxXy = Vec2{std::max(maxXy.x, p.x), std::max(maxXy.y, p.y)};
+			}
+		}
+		const float pad = strokeWidth * 0.5f;
+		bounds.localMin = bounds.isEmpty ? Vec2{0.0f, 0.0f} : minXy - Vec2{pad, pad};
+		bounds.localMax = bounds.isEmpty ? Vec2{0.0f, 0.0f} : maxXy + Vec2{pad, pad};
+	}
+
+	bounds.worldRevision = world.revision;
+	const auto& m = world.worldTransform;
+	bounds.worldObb[0] = bounds.localMin * m;
+	bounds.worldObb[1] = Vec2{bounds.localMax.x, bounds.localMin.y} * m;
+	bounds.worldObb[2] = bounds.localMax * m;
+	bounds.worldObb[3] = Vec2{bounds.localMin.x, bounds.localMax.y} * m;
+
+	bounds.worldMin = bounds.worldMax = bounds.worldObb[0];
+	for (const auto& p : bounds.worldObb)
+	{
+		bounds.worldMin = Vec2{std::min(bounds.worldMin.x, p.x), std::min(bounds.worldMin.y, p.y)};
+		bounds.worldMax = Vec2{std::max(bounds.worldMax.x, p.x), std::max(bounds.worldMax.y, p.y)};
+	}
+}
+static void Update(OutlineComponent& outline, const ShapeComponent& shape)
+{
+	if (outline.pathRevision == shape.pathRevision)
+		return;
+
+	outline.pathRevision = shape.pathRevision;
+	outline.points.clear();
+	outline.contourEnds.clear();
+	outline.isClosed.clear();
+
+	// a contour starts with its first drawing command, so a moveTo alone leaves nothing behind
+	Vec2 current{0.0f, 0.0f};
+	uint32_t begin = 0;
+	auto beginSegment = [&outline, &current, &begin]()
+	{
+		if (outline.points.size() == begin)
+			outline.points.push_back(current);
+	};
+	auto endContour = [&outline, &current, &begin](bool isClosed)
+	{
+		if (outline.points.size() == begin)
+			return;
+		if (isClosed)
+			current = outline.points[begin];
+		outline.contourEnds.push_back(static_cast<uint32_t>(outline.points.size()));
+		outline.isClosed.push_back(isClosed);
+		begin = static_cast<uint32_t>(outline.points.size());
+	};
+
+	for (const auto& applied : shape.segments)
+	{
+		const auto* pt = applied.segment->points.data();
+		for (auto command : applied.segment->commands)
+		{
+			switch (command)
+			{
+				case tvg::PathCommand::MoveTo:
+				{
+					endContour(false);
+					current = Vec2{pt->x, pt->y};
+					pt++;
+					break;
+				}
+				case tvg::PathCommand::LineTo:
+				{
+					beginSegment();
+					current = Vec2{pt->x, pt->y};
+					outline.points.push_back(current);
+					pt++;
+					break;
+				}
+				case tvg::PathCommand::CubicTo:
+				{
+					beginSegment();
+					const Vec2 p0 = current;
+					const Vec2 p1{pt[0].x, pt[0].y};
+					const Vec2 p2{pt[1].x, pt[1].y};
+					const Vec2 p3{pt[2].x, pt[2].y};
+					pt += 3;
+
+					// the control polygon is never shorter than the curve
+					const float length = core::length(p1 - p0) + core::length(p2 - p1) + core::length(p3 - p2);
+					const int count =
+						std::clamp(static_cast<int>(std::ceil(length / OutlineComponent::Size_FlattenStep)), 1,
+								   OutlineComponent::Count_MaxCurveSegment);
+					for (int i = 1; i <= count; i++)
+					{
+						const float t = static_cast<float>(i) / count;
+						const float it = 1.0f - t;
+						outline.points.push_back(p0 * (it * it * it) + p1 * (3.0f * it * it * t) +
+												 p2 * (3.0f * it * t * t) + p3 * (t * t * t));
+					}
+					current = p3;
+					break;
+				}
+				case tvg::PathCommand::Close:
+				{
+					endContour(true);
+					break;
+				}
+			}
+		}
+	}
+	endContour(false);
 }
+
 // shape.shape->reset();
 
+static inline uint32_t ToRgba(const Vec3& color, float alpha)
+{
+	return (static_cast<uint32_t>(static_cast<uint8_t>(color.x)) << 24) |
+		   (static_cast<uint32_t>(static_cast<uint8_t>(color.y)) << 16) |
+		   (static_cast<uint32_t>(static_cast<uint8_t>(color.z)) << 8) | static_cast<uint32_t>(static_cast<uint8_t>(alpha));
+}
+
 static void Update(ShapeComponent& shape, SolidFillComponent& fill)
 {
-	shape.shape->fill(static_cast<uint8_t>(fill.color.x), static_cast<uint8_t>(fill.color.y),
-					  static_cast<uint8_t>(fill.color.z), static_cast<uint8_t>(fill.alpha));
-	shape.shape->fillRule(fill.rule);
+	const auto rgba = ToRgba(fill.color, fill.alpha);
+	if (!fill.isColorApplied || fill.appliedRgba != rgba)
+	{
+		shape.shape->fill(static_cast<uint8_t>(fill.color.x), static_cast<uint8_t>(fill.color.y),
+						  static_cast<uint8_t>(fill.color.z), static_cast<uint8_t>(fill.alpha));
+		fill.appliedRgba = rgba;
+		fill.isColorApplied = true;
+	}
+	if (!fill.isRuleApplied || fill.appliedRule != fill.rule)
+	{
+		shape.shape->fillRule(fill.rule);
+		fill.appliedRule = fill.rule;
+		fill.isRuleApplied = true;
+	}
 }
 
 static void Update(ShapeComponent& shape, StrokeComponent& stroke)
 {
-	shape.shape->strokeWidth(stroke.width);
-	shape.shape->strokeFill(static_cast<uint32_t>(stroke.color.x), static_cast<uint32_t>(stroke.color.y),
-							static_cast<uint32_t>(stroke.color.z), static_cast<uint32_t>(stroke.alpha));
-	shape.shape->order(true);
-	shape.shape->strokeJoin(tvg::StrokeJoin::Round);
-	shape.shape->strokeCap(tvg::StrokeCap::Round);
+	if (!stroke.isWidthApplied || stroke.appliedWidth != stroke.width)
+	{
+		shape.shape->strokeWidth(stroke.width);
+		stroke.appliedWidth = stroke.width;
+		stroke.isWidthApplied = true;
+	}
+	const auto rgba = ToRgba(stroke.color, stroke.alpha);
+	if (!stroke.isColorApplied || stroke.appliedRgba != rgba)
+	{
+		shape.shape->strokeFill(static_cast<uint32_t>(stroke.color.x), static_cast<uint32_t>(stroke.color.y),
+								static_cast<uint32_t>(stroke.color.z), static_cast<uint32_t>(stroke.alpha));
+		stroke.appliedRgba = rgba;
+		stroke.isColorApplied = true;
+	}
+	if (!stroke.isStyleApplied)
+	{
+		shape.shape->order(true);
+		shape.shape->strokeJoin(tvg::StrokeJoin::Round);
+		shape.shape->strokeCap(tvg::StrokeCap::Round);
+		stroke.isStyleApplied = true;
+	}
 }
 
 template <typename TComponent>
@@ -492,6 +906,7 @@ static void Resolve(TransformComponent& transform, RawPath& path)
 static bool Remove(ShapeComponent& shape, SolidFillComponent& fill)
 {
 	shape.shape->fill(0, 0, 0, 0);
+	fill.isColorApplied = false;
 	return true;
 }
 
@@ -499,6 +914,8 @@ static bool Remove(ShapeComponent& shape, StrokeComponent& stroke)
 {
 	shape.shape->strokeWidth(0.0f);
 	shape.shape->strokeFill(0, 0, 0, 0);
+	stroke.isWidthApplied = false;
+	stroke.isColorApplied = false;
 	return true;
 }
 
@@ -512,6 +929,60 @@ static bool RemoveShape(Entity& entity)
 	return false;
 }
 
+// links the world transform of entity under its parent
+static void AttachWorldTransform(Entity& entity)
+{
+	auto& world = entity.getComponent<WorldTransformComponent>();
+	if (world.parent.isNull())
+		return;
+
+	auto& parentWorld = world.parent.getComponent<WorldTransformComponent>();
+	world.childIndex = parentWorld.children.size();
+	parentWorld.children.push_back(entity);
+}
+
+static void DetachWorldTransform(Entity& entity)
+{
+	auto& world = entity.getComponent<WorldTransformComponent>();
+	if (world.parent.isNull())
+		return;
+
+	auto& siblings = world.parent.getComponent<WorldTransformComponent>().children;
+	Entity last = siblings.back();
+	last.getComponent<WorldTransformComponent>().childIndex = world.childIndex;
+	siblings[world.childIndex] = last;
+	siblings.pop_back();
+	world.parent = Entity();
+}
+
+// hands the children of entity over to its parent, so none keeps a handle to entity after it is destroyed
+static void ReparentWorldTransformChildren(Entity& entity)
+{
+	auto& world = entity.getComponent<WorldTransformComponent>();
+	for (auto& child : world.children)
+	{
+		child.getComponent<WorldTransformComponent>().parent = world.parent;
+		AttachWorldTransform(child);
+	}
+	world.children.clear();
+}
+
+// recomputes the world transform of entity and then of its subtree (parent before child)
+static void UpdateWorldTransform(Entity& entity)
+{
+	auto& world = entity.getComponent<WorldTransformComponent>();
+	const auto& transform = entity.getComponent<TransformComponent>();
+	if (world.parent.isNull())
+		world.update(identity(), transform);
+	else
+		world.update(world.parent.getComponent<WorldTransformComponent>().worldTransform, transform);
+
+	for (auto& child : world.children)
+	{
+		UpdateWorldTransform(child);
+	}
+}
+
 template <typename TComponent, typename Function, typename... Args>
 static void CallIfHas(const core::Entity& e, Function f, Args&&... args)
 {
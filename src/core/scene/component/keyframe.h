@@ -9,6 +9,10 @@
 #include <memory>
 #include <vector>
 #include <algorithm>
+#include <atomic>
+#include <limits>
+#include <type_traits>
+#include <cmath>
 
 #define UPDATE_KEYFRAME(KF, DST, FRAME, CHANGED) \
 	if ((KF).isEnable)                           \
@@ -24,81 +28,426 @@
 namespace core
 {
 
+// css style cubic-bezier easing with P0 = (0, 0), P3 = (1, 1).
+// set() precomputes the polynomial and a table of x(t) samples, so progress() takes a table lookup,
+// a few newton-raphson steps (bisection when the slope is too flat) and one polynomial for y
+struct CubicBezierEasing
+{
+	static constexpr int Count_Sample = 11;
+	static constexpr float Step_Sample = 1.0f / (Count_Sample - 1);
+
+	Vec2 p1{0.0f, 0.0f};
+	Vec2 p2{0.0f, 0.0f};
+
+	void set(const Vec2& c1, const Vec2& c2)
+	{
+		p1 = c1;
+		p2 = c2;
+
+		cx = 3.0f * p1.x;
+		bx = 3.0f * (p2.x - p1.x) - cx;
+		ax = 1.0f - cx - bx;
+		cy = 3.0f * p1.y;
+		by = 3.0f * (p2.y - p1.y) - cy;
+		ay = 1.0f - cy - by;
+
+		for (int i = 0; i < Count_Sample; i++)
+		{
+			samples[i] = sampleX(i * Step_Sample);
+		}
+	}
+
+	bool isSame(const Vec2& c1, const Vec2& c2) const
+	{
+		return p1.x == c1.x && p1.y == c1.y && p2.x == c2.x && p2.y == c2.y;
+	}
+
+	float progress(float x) const
+	{
+		x = std::clamp(x, 0.0f, 1.0f);
+		return sampleY(solveT(x));
+	}
+
+private:
+	float sampleX(float t) const
+	{
+		return ((ax * t + bx) * t + cx) * t;
+	}
+	float sampleY(float t) const
+	{
+		return ((ay * t + by) * t + cy) * t;
+	}
+	float slopeX(float t) const
+	{
+		return (3.0f * ax * t + 2.0f * bx) * t + cx;
+	}
+
+	float solveT(float x) const
+	{
+		constexpr float eps = 1e-6f;
+
+		// initial guess from the sample table
+		int i = 0;
+		while (i < Count_Sample - 2 && samples[i + 1] < x)
+		{
+			i++;
+		}
+		const float range = samples[i + 1] - samples[i];
+		float t = i * Step_Sample + (range > 0.0f ? (x - samples[i]) / range * Step_Sample : 0.0f);
+
+		float slope = slopeX(t);
+		if (slope >= 1e-3f)
+		{
+			for (int n = 0; n < 4; n++)
+			{
+				const float dx = sampleX(t) - x;
+				if (fabsf(dx) < eps)
+					return t;
+				t = std::clamp(t - dx / slopeX(t), 0.0f, 1.0f);
+			}
+			if (fabsf(sampleX(t) - x) < 1e-5f)
+				return t;
+		}
+
+		float lo = 0.0f, hi = 1.0f;
+		t = x;
+		for (int n = 0; n < 32; n++)
+		{
+			const float dx = sampleX(t) - x;
+			if (fabsf(dx) < eps)
+				break;
+			(dx < 0.0f) ? lo = t : hi = t;
+			t = 0.5f * (lo + hi);
+		}
+		return t;
+	}
+
+private:
+	float ax{0.0f}, bx{0.0f}, cx{0.0f};
+	float ay{0.0f}, by{0.0f}, cy{0.0f};
+	float samples[Count_Sample]{};
+};
+
 inline float cubicBezierProgress(const Vec2& p1, const Vec2& p2, float t)
 {
-	t = std::clamp(t, 0.0f, 1.0f);
+	CubicBezierEasing easing;
+	easing.set(p1, p2);
+	return easing.progress(t);
+}
 
-	auto bezier = [](float s, float p0, float p1, float p2, float p3)
+// number of samples the bake stage may still compute in the current update, shared by the worker threads,
+// and how the samples are stored
+struct BakeBudget
+{
+	std::atomic<int64_t> samples{0};
+	bool isQuantized{false};	// store the samples as 16 bits per channel instead of full values
+
+	bool take(int64_t count)
 	{
-		float u = 1.0f - s;
-		return u * u * u * p0 + 3.0f * u * u * s * p1 + 3.0f * u * s * s * p2 + s * s * s * p3;
-	};
+		return samples.fetch_sub(count, std::memory_order_relaxed) >= count;
+	}
+};
+
+// bumped by every keyframe edit (main thread), constant ranges computed before it are stale
+inline uint32_t gKeyframeRevision{1};
+
+// frames [from, until] over which a track, or every track of a component, keeps its value
+struct ConstantRange
+{
+	float from{std::numeric_limits<float>::infinity()};	   // empty by default
+	float until{-std::numeric_limits<float>::infinity()};
+	uint32_t revision{0};
+
+	static ConstantRange All()
+	{
+		constexpr float inf = std::numeric_limits<float>::infinity();
+		return ConstantRange{-inf, inf, gKeyframeRevision};
+	}
+	static ConstantRange At(float frameNo)
+	{
+		return ConstantRange{frameNo, frameNo, gKeyframeRevision};
+	}
 
-	float lo = 0.0f, hi = 1.0f, s = 0.5f;
-	const float eps = 1e-4f;
-	for (int i = 0; i < 256; ++i)
+	bool contains(float frameNo) const
+	{
+		return revision == gKeyframeRevision && from <= frameNo && frameNo <= until;
+	}
+	ConstantRange& operator&=(const ConstantRange& rhs)
 	{
-		s = 0.5f * (lo + hi);
-		float x = bezier(s, 0.0f, p1.x, p2.x, 1.0f);
-		if (fabsf(x - t) < eps)
-			break;
-		(x < t) ? lo = s : hi = s;
+		from = std::max(from, rhs.from);
+		until = std::min(until, rhs.until);
+		return *this;
 	}
+};
 
-	return bezier(s, 0.0f, p1.y, p2.y, 1.0f);
+// widens the segment around key idx (first key >= frameNo, keyCount if none) over the neighbouring keys
+// that hold the same value. isSame(i) compares key i with key i + 1
+template <typename FrameOf, typename IsSame>
+static ConstantRange FindConstantRange(float frameNo, size_t idx, size_t keyCount, FrameOf frameOf, IsSame isSame)
+{
+	constexpr float inf = std::numeric_limits<float>::infinity();
+
+	size_t lo = idx > 0 ? idx - 1 : 0;
+	size_t hi = idx < keyCount ? idx : keyCount - 1;
+	if (lo != hi && !isSame(lo))
+		return ConstantRange::At(frameNo);
+
+	while (lo > 0 && isSame(lo - 1))
+	{
+		lo--;
+	}
+	while (hi + 1 < keyCount && isSame(hi))
+	{
+		hi++;
+	}
+	return ConstantRange{lo == 0 ? -inf : frameOf(lo), hi + 1 == keyCount ? inf : frameOf(hi), gKeyframeRevision};
+}
+
+// number of float channels of a track value, baked samples are quantized per channel
+template <typename T>
+static constexpr size_t ChannelCount()
+{
+	if constexpr (std::is_arithmetic_v<T>)
+		return 1;
+	else
+		return sizeof(T) / sizeof(typename T::element_type);
+}
+
+template <typename T>
+static float GetChannel(const T& value, size_t channel)
+{
+	if constexpr (std::is_arithmetic_v<T>)
+		return static_cast<float>(value);
+	else
+		return static_cast<float>(value[channel]);
+}
+
+template <typename T>
+static void SetChannel(T& value, size_t channel, float channelValue)
+{
+	if constexpr (std::is_arithmetic_v<T>)
+		value = static_cast<T>(channelValue);
+	else
+		value[channel] = channelValue;
 }
 
 template <typename T>
 struct Keyframes
 {
+	static constexpr uint32_t Index_Linear = UINT32_MAX;
+	static constexpr size_t Index_None = SIZE_MAX;
+	static constexpr size_t Count_Channel = ChannelCount<T>();
+
 	struct Keyframe
 	{
 		uint32_t frame{0};
-		T value{0};
-		Vec2 inTangent{0, 0};
-		Vec2 outTangent{0, 0};
+		T value{};
+		uint32_t tangent{Index_Linear};	   // index in the tangents of the track, Index_Linear if both are zero
 
 		bool operator<(const Keyframe& rhs) const
 		{
 			return frame < rhs.frame;
 		}
 	};
+	struct Tangent
+	{
+		Vec2 in{0, 0};
+		Vec2 out{0, 0};
+	};
+	// a key with its tangents, input of merge()
+	struct KeyframeDesc
+	{
+		uint32_t frame{0};
+		T value{};
+		Vec2 inTangent{0, 0};
+		Vec2 outTangent{0, 0};
+	};
+
+	// true once the first key is added, the track storage is allocated at the same time
 	bool isEnable{false};
-	std::vector<Keyframe> frames;
 
 	auto begin()
 	{
-		return frames.begin();
+		return mTrack ? mTrack->frames.begin() : typename std::vector<Keyframe>::iterator{};
 	}
 	auto end()
 	{
-		return frames.end();
+		return mTrack ? mTrack->frames.end() : typename std::vector<Keyframe>::iterator{};
+	}
+	size_t size() const
+	{
+		return mTrack ? mTrack->frames.size() : 0;
 	}
 
 	void add(uint32_t frameNo, const T& value)
 	{
-		auto it = std::find_if(frames.begin(), frames.end(),
-							   [frameNo](const auto& keyframe) { return frameNo == keyframe.frame; });
-		if (it == frames.end())
+		auto& frames = track().frames;
+		auto it = std::lower_bound(frames.begin(), frames.end(), frameNo,
+								   [](const Keyframe& k, uint32_t f) { return k.frame < f; });
+		if (it == frames.end() || it->frame != frameNo)
 		{
 			isEnable = true;
 			if (frames.empty() && frameNo != 0)
 			{
 				frames.push_back(Keyframe{.frame = 0, .value = value});
+				it = frames.end();
 			}
-			frames.push_back(Keyframe{.frame = frameNo, .value = value});
-			std::sort(frames.begin(), frames.end());
+			frames.insert(it, Keyframe{.frame = frameNo, .value = value});
 		}
 		else
 		{
 			it->value = value;
 		}
+		// the keys stay sorted and no tangent slot is released, so the sort and compaction of markEdited() are
+		// skipped. called on every tick of a live drag: the samples are only marked stale, their storage is kept
+		// for the next bake
+		track().bakedCount = 0;
+		gKeyframeRevision++;
+	}
+
+	// merges keys sorted by strictly increasing frame into the track in one pass, keys replace existing keys
+	// on the same frame (value and tangents). returns false and leaves the track unchanged if keys are not sorted
+	bool merge(const KeyframeDesc* keys, size_t count)
+	{
+		for (size_t i = 1; i < count; i++)
+		{
+			if (keys[i - 1].frame >= keys[i].frame)
+				return false;
+		}
+		if (count == 0)
+			return true;
+
+		auto& t = track();
+		std::vector<Keyframe> merged;
+		merged.reserve(t.frames.size() + count + 1);
+		if (t.frames.empty() && keys[0].frame != 0)
+		{
+			merged.push_back(Keyframe{.frame = 0, .value = keys[0].value});
+		}
+
+		size_t i = 0;
+		size_t j = 0;
+		while (i < t.frames.size() || j < count)
+		{
+			if (j == count || (i < t.frames.size() && t.frames[i].frame < keys[j].frame))
+			{
+				merged.push_back(t.frames[i++]);
+				continue;
+			}
+			if (i < t.frames.size() && t.frames[i].frame == keys[j].frame)
+			{
+				t.hasUnusedTangent |= t.frames[i].tangent != Index_Linear;
+				i++;
+			}
+			Keyframe key{.frame = keys[j].frame, .value = keys[j].value};
+			setTangents(key, keys[j].inTangent, keys[j].outTangent);
+			merged.push_back(key);
+			j++;
+		}
+
+		t.frames = std::move(merged);
+		isEnable = true;
+		markEdited();
+		return true;
+	}
+
+	Vec2 inTangent(const Keyframe& key) const
+	{
+		return key.tangent == Index_Linear ? Vec2{0, 0} : mTrack->tangents[key.tangent].in;
+	}
+	Vec2 outTangent(const Keyframe& key) const
+	{
+		return key.tangent == Index_Linear ? Vec2{0, 0} : mTrack->tangents[key.tangent].out;
+	}
+	// key must belong to this track (or be merged into it), linear tangents free its slot
+	void setTangents(Keyframe& key, const Vec2& in, const Vec2& out)
+	{
+		auto& t = track();
+		if (IsLinearTangent(in) && IsLinearTangent(out))
+		{
+			t.hasUnusedTangent |= key.tangent != Index_Linear;
+			key.tangent = Index_Linear;
+			return;
+		}
+		if (key.tangent == Index_Linear)
+		{
+			key.tangent = static_cast<uint32_t>(t.tangents.size());
+			t.tangents.push_back(Tangent{in, out});
+			return;
+		}
+		t.tangents[key.tangent] = Tangent{in, out};
+	}
+
+	// must be called after frames are edited directly. keys moved out of order are sorted back with their tangents,
+	// keys that landed on the same frame are merged: the key at movedIndex (e.g. the one dragged) wins, else the last
+	void markEdited(size_t movedIndex = Index_None)
+	{
+		if (mTrack)
+		{
+			sortFrames(movedIndex);
+			clearBake();
+			if (mTrack->hasUnusedTangent)
+				compactTangents();
+		}
+		gKeyframeRevision++;
+	}
+
+	// samples an eased track over [from, to] unless it is already baked for that range.
+	// skipped (left to interpolation) when the budget of this update is spent. a linear track is interpolated
+	// about as fast as a sample is read back, so it is never baked
+	void bake(uint32_t from, uint32_t to, BakeBudget& budget)
+	{
+		if (!isEnable || !mTrack || mTrack->frames.size() < 2 || to < from || !isEased())
+			return;
+
+		auto& t = *mTrack;
+		const size_t count = static_cast<size_t>(to - from) + 1;
+		const bool isQuantized = budget.isQuantized && !std::is_integral_v<T>;
+		if (t.bakedFrom == from && t.bakedCount == count && t.isBakeQuantized == isQuantized)
+			return;
+		if (!budget.take(static_cast<int64_t>(count)))
+			return;
+
+		// frame() interpolates while the samples are taken, the storage of the last bake is reused
+		t.bakedCount = 0;
+		std::vector<T> values = std::move(t.baked);
+		values.resize(count);
+		for (size_t i = 0; i < count; i++)
+		{
+			values[i] = frame(static_cast<float>(from + i));
+		}
+		if (isQuantized)
+		{
+			quantize(values);
+			t.baked.clear();
+		}
+		else
+		{
+			t.baked = std::move(values);
+			t.quantized.clear();
+			t.quantized.shrink_to_fit();
+		}
+		t.bakedFrom = from;
+		t.bakedCount = count;
+		t.isBakeQuantized = isQuantized;
+	}
+
+	void clearBake()
+	{
+		if (!mTrack)
+			return;
+		mTrack->baked.clear();
+		mTrack->baked.shrink_to_fit();
+		mTrack->quantized.clear();
+		mTrack->quantized.shrink_to_fit();
+		mTrack->bakedCount = 0;
 	}
 	Keyframe* left(float frameNo)
 	{
-		if (frames.empty())
+		if (!mTrack || mTrack->frames.empty())
 			return nullptr;
 
+		auto& frames = mTrack->frames;
 		auto it = std::lower_bound(frames.begin(), frames.end(), frameNo,
 								   [](const Keyframe& k, float f) { return k.frame < f; });
 		if (it == frames.end() || it == frames.begin())
@@ -109,8 +458,10 @@ struct Keyframes
 	}
 	Keyframe* right(float frameNo)
 	{
-		if (frames.empty())
+		if (!mTrack || mTrack->frames.empty())
 			return nullptr;
+
+		auto& frames = mTrack->frames;
 		auto it = std::lower_bound(frames.begin(), frames.end(), frameNo,
 								   [](const Keyframe& k, float f) { return k.frame < f; });
 		if (it == frames.end())
@@ -122,42 +473,259 @@ struct Keyframes
 
 	T frame(float frameNo)
 	{
-		if (!isEnable || frames.empty())
+		if (!isEnable || !mTrack || mTrack->frames.empty())
 		{
 			assert(false);
 			return T{};
 		}
+		auto& t = *mTrack;
+		const auto& frames = t.frames;
 		if (frames.size() == 1)
 			return frames[0].value;
 
-		auto it = std::lower_bound(frames.begin(), frames.end(), frameNo,
-								   [](const Keyframe& k, float f) { return k.frame < f; });
+		// baked samples hold integer frames only, a fractional frame follows the eased curve between the keys.
+		// quantized samples are off the curve by up to one level, so a fractional frame is read between the two
+		// samples around it instead, otherwise sub-frame playback would step between quantized and exact values
+		if (t.bakedCount > 0 && frameNo >= static_cast<float>(t.bakedFrom))
+		{
+			const float offset = frameNo - static_cast<float>(t.bakedFrom);
+			const size_t i = static_cast<size_t>(offset);
+			if (i < t.bakedCount && offset == static_cast<float>(i))
+				return bakedAt(i);
+			if (t.isBakeQuantized && i + 1 < t.bakedCount)
+				return lerp(bakedAt(i), bakedAt(i + 1), offset - static_cast<float>(i));
+		}
 
-		if (it == frames.end())
+		const size_t idx = seek(frameNo);
+
+		if (idx == frames.size())
 		{
 			return frames.back().value;
 		}
-		if (frames.begin() == it)
+		if (idx == 0)
 		{
-			return it->value;
+			return frames[0].value;
 		}
 
-		const auto& lo = *(it - 1);
-		const auto& hi = *it;
+		const auto& lo = frames[idx - 1];
+		const auto& hi = frames[idx];
 		const float denom = float(hi.frame - lo.frame);
-		const float t = denom > 0.f ? (frameNo - static_cast<float>(lo.frame)) / denom : 0.f;
-		const bool linear = (fabsf(lo.outTangent.x) < 1e-6f && fabsf(lo.outTangent.y) < 1e-6f &&
-							 fabsf(hi.inTangent.x) < 1e-6f && fabsf(hi.inTangent.y) < 1e-6f);
+		const float u = denom > 0.f ? (frameNo - static_cast<float>(lo.frame)) / denom : 0.f;
+		assert(u >= 0.0f && u <= 1.0f);
+
+		// linear keys carry no tangents, the common case needs no lookup
+		if (lo.tangent == Index_Linear && hi.tangent == Index_Linear)
+			return lerp(lo.value, hi.value, u);
+
+		const Vec2 out = outTangent(lo);
+		const Vec2 in = inTangent(hi);
+		if (IsLinearTangent(out) && IsLinearTangent(in))
+			return lerp(lo.value, hi.value, u);
+
+		if (!t.easing.isSame(out, in))
+			t.easing.set(out, in);
+		return lerp(lo.value, hi.value, t.easing.progress(u));
+	}
+
+	// frames around frameNo over which the value does not change, so callers can skip evaluating the track.
+	// a track without animation is constant everywhere
+	ConstantRange constantRange(float frameNo)
+	{
+		if (!isEnable || !mTrack || mTrack->frames.size() < 2)
+			return ConstantRange::All();
+
+		auto& frames = mTrack->frames;	 // the operator== of Vec2 and Vec3 is not const
+		return FindConstantRange(
+			frameNo, seek(frameNo), frames.size(), [&frames](size_t i) { return static_cast<float>(frames[i].frame); },
+			[&frames](size_t i) { return frames[i].value == frames[i + 1].value; });
+	}
+
+	// bytes allocated by the track without its baked samples, the inline size is counted by the owner.
+	// 0 for an unanimated property
+	size_t memoryUsage() const
+	{
+		if (!mTrack)
+			return 0;
+
+		const auto& t = *mTrack;
+		return sizeof(Track) + t.frames.capacity() * sizeof(Keyframe) + t.tangents.capacity() * sizeof(Tangent);
+	}
+	// bytes allocated by the baked samples, see bake()
+	size_t bakeMemoryUsage() const
+	{
+		if (!mTrack)
+			return 0;
+
+		return mTrack->baked.capacity() * sizeof(T) + mTrack->quantized.capacity() * sizeof(uint16_t);
+	}
+
+private:
+	// state of an animated property, allocated with the first key
+	struct Track
+	{
+		std::vector<Keyframe> frames;
+		std::vector<Tangent> tangents;	  // eased keys only
+		bool hasUnusedTangent{false};	  // slots released by linear or replaced keys, dropped by markEdited()
+
+		// index of the key found by the last frame() call. it is only a hint, checked on every use,
+		// so frames can still be edited directly (timeline drag, curve edit), followed by markEdited()
+		size_t cursor{0};
+		// solver of the last eased segment, rebuilt when the tangents it was built for change
+		CubicBezierEasing easing;
+
+		// the track sampled at every integer frame of [bakedFrom, bakedFrom + bakedCount), see bake().
+		// stored in baked, or in quantized as 16 bits per channel over the range of each channel
+		std::vector<T> baked;
+		std::vector<uint16_t> quantized;
+		float quantizeMin[Count_Channel]{};
+		float quantizeStep[Count_Channel]{};
+		uint32_t bakedFrom{0};
+		size_t bakedCount{0};
+		bool isBakeQuantized{false};
+	};
+
+	static bool IsLinearTangent(const Vec2& tangent)
+	{
+		return fabsf(tangent.x) < 1e-6f && fabsf(tangent.y) < 1e-6f;
+	}
+
+	// markEdited() drops the tangent slots of linear keys, so only a track with an eased key has tangents
+	bool isEased() const
+	{
+		return !mTrack->tangents.empty();
+	}
+
+	Track& track()
+	{
+		if (!mTrack)
+			mTrack = std::make_unique<Track>();
+		return *mTrack;
+	}
+
+	void sortFrames(size_t movedIndex)
+	{
+		auto& t = *mTrack;
+		auto& frames = t.frames;
+		if (std::adjacent_find(frames.begin(), frames.end(),
+							   [](const Keyframe& a, const Keyframe& b) { return a.frame >= b.frame; }) == frames.end())
+			return;
+
+		std::vector<size_t> order(frames.size());
+		for (size_t i = 0; i < order.size(); i++)
+		{
+			order[i] = i;
+		}
+		std::stable_sort(order.begin(), order.end(),
+						 [&frames](size_t a, size_t b) { return frames[a].frame < frames[b].frame; });
+
+		std::vector<Keyframe> sorted;
+		sorted.reserve(frames.size());
+		for (size_t i = 0; i < order.size();)
+		{
+			// one key per frame, the dropped ones release their tangents
+			size_t end = i + 1;
+			size_t keep = order[i];
+			while (end < order.size() && frames[order[end]].frame == frames[order[i]].frame)
+			{
+				if (keep != movedIndex)
+					keep = order[end];
+				end++;
+			}
+			for (size_t j = i; j < end; j++)
+			{
+				t.hasUnusedTangent |= order[j] != keep && frames[order[j]].tangent != Index_Linear;
+			}
+			sorted.push_back(frames[keep]);
+			i = end;
+		}
+		frames = std::move(sorted);
+		t.cursor = 0;
+	}
+
+	void compactTangents()
+	{
+		auto& t = *mTrack;
+		std::vector<Tangent> used;
+		for (auto& key : t.frames)
+		{
+			if (key.tangent == Index_Linear)
+				continue;
+			used.push_back(t.tangents[key.tangent]);
+			key.tangent = static_cast<uint32_t>(used.size() - 1);
+		}
+		t.tangents = std::move(used);
+		t.hasUnusedTangent = false;
+	}
+
+	void quantize(const std::vector<T>& values)
+	{
+		constexpr float Count_Level = 65535.0f;
+		auto& t = *mTrack;
+		for (size_t c = 0; c < Count_Channel; c++)
+		{
+			float lo = std::numeric_limits<float>::max();
+			float hi = std::numeric_limits<float>::lowest();
+			for (const auto& value : values)
+			{
+				lo = std::min(lo, GetChannel(value, c));
+				hi = std::max(hi, GetChannel(value, c));
+			}
+			t.quantizeMin[c] = lo;
+			t.quantizeStep[c] = (hi - lo) / Count_Level;
+		}
+
+		t.quantized.resize(values.size() * Count_Channel);
+		for (size_t i = 0; i < values.size(); i++)
+		{
+			for (size_t c = 0; c < Count_Channel; c++)
+			{
+				const float step = t.quantizeStep[c];
+				const float level = step > 0.0f ? (GetChannel(values[i], c) - t.quantizeMin[c]) / step : 0.0f;
+				t.quantized[i * Count_Channel + c] = static_cast<uint16_t>(std::lround(level));
+			}
+		}
+	}
+
+	T bakedAt(size_t i) const
+	{
+		const auto& t = *mTrack;
+		if (!t.isBakeQuantized)
+			return t.baked[i];
 
-		assert(t >= 0.0f && t <= 1.0f);
-		float u = t;
-		if (!linear)
+		T value{};
+		const uint16_t* levels = t.quantized.data() + i * Count_Channel;
+		for (size_t c = 0; c < Count_Channel; c++)
 		{
-			u = cubicBezierProgress(lo.outTangent, hi.inTangent, t);
+			SetChannel(value, c, t.quantizeMin[c] + levels[c] * t.quantizeStep[c]);
 		}
+		return value;
+	}
 
-		return lerp(lo.value, hi.value, u);
+	bool isCursorAt(size_t idx, float frameNo) const
+	{
+		const auto& frames = mTrack->frames;
+		return idx <= frames.size() && (idx == 0 || frames[idx - 1].frame < frameNo) &&
+			   (idx == frames.size() || frames[idx].frame >= frameNo);
 	}
+
+	// first key with frame >= frameNo (frames.size() if none), same as lower_bound.
+	// playback moves forward, so the cached key or the next one is checked before a binary search
+	size_t seek(float frameNo)
+	{
+		auto& t = *mTrack;
+		if (isCursorAt(t.cursor, frameNo))
+			return t.cursor;
+		if (isCursorAt(t.cursor + 1, frameNo))
+			return ++t.cursor;
+
+		auto it = std::lower_bound(t.frames.begin(), t.frames.end(), frameNo,
+								   [](const Keyframe& k, float f) { return k.frame < f; });
+		t.cursor = static_cast<size_t>(it - t.frames.begin());
+		return t.cursor;
+	}
+
+private:
+	std::unique_ptr<Track> mTrack;
 };
 
 using IntegerKeyFrame = Keyframes<int>;
@@ -179,27 +747,207 @@ struct PathPoint
 	Vec2 deltaLeftControlPosition{0.0f, 0.0f};
 	Vec2 deltaRightControlPosition{0.0f, 0.0f};
 	Command type{Command::LineTo};
+};
 
-	VectorKeyFrame localPositionKeyframe;
-	VectorKeyFrame deltaLeftControlPositionKeyframe;
-	VectorKeyFrame deltaRightControlPositionKeyframe;
+using PathPoints = std::vector<PathPoint>;
 
-	bool update(float frameNo)
+// keyframes of a whole RawPath (morphing), stored as structure of arrays:
+// one time axis shared by every point, and per key contiguous x/y arrays of the point positions and control deltas.
+// frame() interpolates all points in one pass over those arrays instead of one keyframe track per point
+struct PathMorphKeyframes
+{
+	struct Key
 	{
-		bool changed = false;
+		uint32_t frame{0};
+		Vec2 inTangent{0, 0};
+		Vec2 outTangent{0, 0};
+	};
+
+	bool isEnable{false};
+	size_t pointCount{0};
+	std::vector<Key> keys;
+
+	// values of key k start at k * pointCount * 2, as x, y pairs
+	std::vector<float> positions;
+	std::vector<float> leftControls;
+	std::vector<float> rightControls;
+
+	// returns false if the point count differs from the keys already added. the tangents ease the segments
+	// around the key like the tangents of Keyframes<T>, zero tangents interpolate linearly
+	bool add(uint32_t frameNo,
+			 const PathPoints& points,
+			 const Vec2& inTangent = {0, 0},
+			 const Vec2& outTangent = {0, 0})
+	{
+		if (!keys.empty() && points.size() != pointCount)
+			return false;
+
+		pointCount = points.size();
+		isEnable = true;
+
+		auto it = std::lower_bound(keys.begin(), keys.end(), frameNo,
+								   [](const Key& k, uint32_t f) { return k.frame < f; });
+		const size_t idx = static_cast<size_t>(it - keys.begin());
+		if (it == keys.end() || it->frame != frameNo)
+		{
+			keys.insert(it, Key{.frame = frameNo});
+			const size_t at = idx * pointCount * 2;
+			positions.insert(positions.begin() + at, pointCount * 2, 0.0f);
+			leftControls.insert(leftControls.begin() + at, pointCount * 2, 0.0f);
+			rightControls.insert(rightControls.begin() + at, pointCount * 2, 0.0f);
+		}
+		keys[idx].inTangent = inTangent;
+		keys[idx].outTangent = outTangent;
+
+		gKeyframeRevision++;
+
+		float* position = positions.data() + idx * pointCount * 2;
+		float* left = leftControls.data() + idx * pointCount * 2;
+		float* right = rightControls.data() + idx * pointCount * 2;
+		for (size_t i = 0; i < pointCount; i++)
+		{
+			const auto& p = points[i];
+			position[2 * i] = p.localPosition.x;
+			position[2 * i + 1] = p.localPosition.y;
+			left[2 * i] = p.deltaLeftControlPosition.x;
+			left[2 * i + 1] = p.deltaLeftControlPosition.y;
+			right[2 * i] = p.deltaRightControlPosition.x;
+			right[2 * i + 1] = p.deltaRightControlPosition.y;
+		}
+		return true;
+	}
+
+	void clear()
+	{
+		*this = PathMorphKeyframes{};
+		gKeyframeRevision++;
+	}
 
-		UPDATE_KEYFRAME(localPositionKeyframe, localPosition, frameNo, changed);
-		if (type != Command::LineTo)
+	ConstantRange constantRange(float frameNo)
+	{
+		if (!isEnable || keys.size() < 2)
+			return ConstantRange::All();
+
+		const size_t count = pointCount * 2;
+		auto isSame = [this, count](size_t i)
 		{
-			UPDATE_KEYFRAME(deltaLeftControlPositionKeyframe, deltaLeftControlPosition, frameNo, changed);
-			UPDATE_KEYFRAME(deltaRightControlPositionKeyframe, deltaRightControlPosition, frameNo, changed);
+			const size_t a = i * count;
+			const size_t b = a + count;
+			return std::equal(positions.begin() + a, positions.begin() + b, positions.begin() + b) &&
+				   std::equal(leftControls.begin() + a, leftControls.begin() + b, leftControls.begin() + b) &&
+				   std::equal(rightControls.begin() + a, rightControls.begin() + b, rightControls.begin() + b);
+		};
+		return FindConstantRange(
+			frameNo, seek(frameNo), keys.size(), [this](size_t i) { return static_cast<float>(keys[i].frame); }, isSame);
+	}
+
+	// bytes allocated by the keys and buffers, the inline size is counted by the owner
+	size_t memoryUsage() const
+	{
+		return keys.capacity() * sizeof(Key) +
+			   (positions.capacity() + leftControls.capacity() + rightControls.capacity() + mPosition.capacity() +
+				mLeft.capacity() + mRight.capacity()) *
+				   sizeof(float);
+	}
+
+	// writes the interpolated points, returns true if any of them changed.
+	// points edited to a different count than the keys are left as they are
+	bool frame(float frameNo, PathPoints& points)
+	{
+		if (!isEnable || keys.empty() || points.size() != pointCount)
+			return false;
+
+		size_t lo = 0;
+		size_t hi = 0;
+		float u = 0.0f;
+		const size_t idx = seek(frameNo);
+		if (idx == keys.size())
+		{
+			lo = hi = keys.size() - 1;
+		}
+		else if (idx > 0)
+		{
+			lo = idx - 1;
+			hi = idx;
+			const auto& l = keys[lo];
+			const auto& h = keys[hi];
+			const float denom = float(h.frame - l.frame);
+			u = denom > 0.f ? (frameNo - static_cast<float>(l.frame)) / denom : 0.f;
+			const bool linear = (fabsf(l.outTangent.x) < 1e-6f && fabsf(l.outTangent.y) < 1e-6f &&
+								 fabsf(h.inTangent.x) < 1e-6f && fabsf(h.inTangent.y) < 1e-6f);
+			if (!linear)
+			{
+				if (!easing.isSame(l.outTangent, h.inTangent))
+					easing.set(l.outTangent, h.inTangent);
+				u = easing.progress(u);
+			}
 		}
 
+		const size_t count = pointCount * 2;
+		mPosition.resize(count);
+		mLeft.resize(count);
+		mRight.resize(count);
+		Lerp(positions.data() + lo * count, positions.data() + hi * count, u, mPosition.data(), count);
+		Lerp(leftControls.data() + lo * count, leftControls.data() + hi * count, u, mLeft.data(), count);
+		Lerp(rightControls.data() + lo * count, rightControls.data() + hi * count, u, mRight.data(), count);
+
+		bool changed = false;
+		for (size_t i = 0; i < pointCount; i++)
+		{
+			auto& p = points[i];
+			const Vec2 position{mPosition[2 * i], mPosition[2 * i + 1]};
+			const Vec2 left{mLeft[2 * i], mLeft[2 * i + 1]};
+			const Vec2 right{mRight[2 * i], mRight[2 * i + 1]};
+			if (p.localPosition != position || p.deltaLeftControlPosition != left ||
+				p.deltaRightControlPosition != right)
+			{
+				p.localPosition = position;
+				p.deltaLeftControlPosition = left;
+				p.deltaRightControlPosition = right;
+				changed = true;
+			}
+		}
 		return changed;
 	}
-};
 
-using PathPoints = std::vector<PathPoint>;
+private:
+	// plain loop over contiguous floats, vectorized by the compiler
+	static void Lerp(const float* a, const float* b, float t, float* out, size_t count)
+	{
+		for (size_t i = 0; i < count; i++)
+		{
+			out[i] = a[i] + (b[i] - a[i]) * t;
+		}
+	}
+
+	// first key with frame >= frameNo (keys.size() if none), the last found key is checked first
+	size_t seek(float frameNo)
+	{
+		auto isAt = [this, frameNo](size_t idx)
+		{
+			return idx <= keys.size() && (idx == 0 || keys[idx - 1].frame < frameNo) &&
+				   (idx == keys.size() || keys[idx].frame >= frameNo);
+		};
+		if (isAt(cursor))
+			return cursor;
+		if (isAt(cursor + 1))
+			return ++cursor;
+
+		auto it = std::lower_bound(keys.begin(), keys.end(), frameNo,
+								   [](const Key& k, float f) { return k.frame < f; });
+		cursor = static_cast<size_t>(it - keys.begin());
+		return cursor;
+	}
+
+private:
+	size_t cursor{0};
+	CubicBezierEasing easing;
+
+	// interpolated values, reused across frames
+	std::vector<float> mPosition;
+	std::vector<float> mLeft;
+	std::vector<float> mRight;
+};
 
 }	 // namespace core
 
@@ -1,32 +1,112 @@
 #include "path.h"
 #include "components.h"
 
+#include <cstring>
+#include <unordered_map>
+
 namespace core
 {
 
-void RectPath::appendTo(ShapeComponent& s)
+void RectPath::build(PathSegment& segment)
+{
+	Build(segment, *this);
+}
+
+void EllipsePath::build(PathSegment& segment)
+{
+	Build(segment, *this);
+}
+
+void RawPath::build(PathSegment& segment)
 {
-	Update(s, *this);
+	Build(segment, *this);
 }
 
-void EllipsePath::appendTo(ShapeComponent& s)
+void PolygonPath::build(PathSegment& segment)
 {
-	Update(s, *this);
+	Build(segment, *this);
 }
 
-void RawPath::appendTo(ShapeComponent& s)
+void StarPolygonPath::build(PathSegment& segment)
 {
-	Update(s, *this);
+	Build(segment, *this);
 }
 
-void PolygonPath::appendTo(ShapeComponent& s)
+const UnitCircleTable& GetUnitCircleTable(int count)
 {
-	Update(s, *this);
+	// only accessed while building shapes on the main thread
+	static std::unordered_map<int, UnitCircleTable> tables;
+
+	auto& table = tables[count];
+	if (table.x.size() != count)
+	{
+		const float start = -90.0f;
+		const float step = 360.0f / count;
+		table.x.resize(count);
+		table.y.resize(count);
+		for (int i = 0; i < count; i++)
+		{
+			const float radian = ToRadian(start + i * step);
+			table.x[i] = std::cos(radian);
+			table.y[i] = std::sin(radian);
+		}
+	}
+	return table;
 }
 
-void StarPolygonPath::appendTo(ShapeComponent& s)
+size_t GeometryKeyHash::operator()(const GeometryKey& key) const
 {
-	Update(s, *this);
+	size_t hash = std::hash<int>{}(key.type);
+	for (float param : key.params)
+	{
+		uint32_t bits;
+		std::memcpy(&bits, &param, sizeof(bits));
+		hash ^= std::hash<uint32_t>{}(bits) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+	}
+	return hash;
+}
+
+// segments of parametric paths, shared by every path with the same geometry.
+// entries are weak so a segment is freed with its last user; expired entries are pruned as the map grows
+static std::unordered_map<GeometryKey, std::weak_ptr<PathSegment>, GeometryKeyHash> gGeometryCache;
+static size_t gGeometryCachePruneSize{64};
+
+void IPath::acquireSegment()
+{
+	GeometryKey key;
+	if (!geometryKey(key))
+	{
+		// private segment, rebuilt in place
+		if (!mSegment || mIsSharedSegment)
+		{
+			mSegment = std::make_shared<PathSegment>();
+			mIsSharedSegment = false;
+		}
+		mSegment->commands.clear();
+		mSegment->points.clear();
+		mSegment->revision++;
+		build(*mSegment);
+		return;
+	}
+
+	if (gGeometryCache.size() >= gGeometryCachePruneSize)
+	{
+		std::erase_if(gGeometryCache, [](const auto& entry) { return entry.second.expired(); });
+		gGeometryCachePruneSize = std::max<size_t>(64, gGeometryCache.size() * 2);
+	}
+
+	// release first, so an unshared segment of the old geometry is freed before the lookup
+	mSegment.reset();
+	mIsSharedSegment = true;
+
+	auto& entry = gGeometryCache[key];
+	mSegment = entry.lock();
+	if (!mSegment)
+	{
+		mSegment = std::make_shared<PathSegment>();
+		build(*mSegment);
+		entry = mSegment;
+	}
 }
 
 IPath::IPath()
@@ -10,10 +10,50 @@
 #include <memory>
 #include <vector>
 #include <algorithm>
+#include <cstring>
+
+#include <thorvg.h>
 
 namespace core
 {
-struct ShapeComponent;
+
+// tvg commands generated from one sub-path, rebuilt only when the path version changes
+struct PathSegment
+{
+	std::vector<tvg::PathCommand> commands;
+	std::vector<tvg::Point> points;
+	uint32_t revision{0};	 // bumped when a private segment is rebuilt in place, shared ones never change
+};
+
+// identifies the outline of a parametric path; paths with equal keys share one segment.
+// params are compared by bit pattern like GeometryKeyHash, so -0/0 are distinct keys and a NaN key still finds itself
+struct GeometryKey
+{
+	static constexpr int Count_Param = 5;
+
+	int type{-1};
+	float params[Count_Param]{};
+
+	bool operator==(const GeometryKey& rhs) const
+	{
+		return type == rhs.type && std::memcmp(params, rhs.params, sizeof(params)) == 0;
+	}
+};
+
+struct GeometryKeyHash
+{
+	size_t operator()(const GeometryKey& key) const;
+};
+
+// vertices evenly spaced on the unit circle, starting at the top (-90 degrees) and going clockwise.
+// cached per vertex count; polygon and star outlines scale these instead of calling cos/sin per vertex
+struct UnitCircleTable
+{
+	std::vector<float> x;
+	std::vector<float> y;
+};
+const UnitCircleTable& GetUnitCircleTable(int count);
+
 struct IPath
 {
 	enum class Type
@@ -28,7 +68,68 @@ struct IPath
 	virtual ~IPath();
 	virtual Type type() = 0;
 	virtual bool update(float frameNo) = 0;
-	virtual void appendTo(ShapeComponent& s) = 0;
+	// samples the keyframe tracks over [from, to] for update(), see Keyframes::bake
+	virtual void bake(uint32_t from, uint32_t to, BakeBudget& budget)
+	{
+	}
+	// frames around frameNo over which update() changes nothing
+	virtual ConstantRange constantRange(float frameNo)
+	{
+		return ConstantRange::All();
+	}
+	// inline size of the path and the bytes allocated by its points and keyframe tracks, without baked samples
+	virtual size_t memoryUsage() const = 0;
+	// bytes allocated by the baked samples of the keyframe tracks, see bake()
+	virtual size_t bakeMemoryUsage() const
+	{
+		return 0;
+	}
+
+	// must be called after the path is edited outside of update()
+	void markChanged()
+	{
+		version++;
+	}
+
+	// regenerates the cached segment if the path changed since it was built.
+	// static parametric paths share the segment with every path of the same geometry (see geometryKey)
+	const std::shared_ptr<PathSegment>& segment(bool isForce = false)
+	{
+		if (isForce || !mSegment || mSegmentVersion != version)
+		{
+			acquireSegment();
+			mSegmentVersion = version;
+		}
+		return mSegment;
+	}
+
+	uint32_t version{1};
+
+protected:
+	virtual void build(PathSegment& segment) = 0;
+
+	// paths whose outline is fully described by a few parameters return true and fill the key.
+	// animated paths return false: their outline changes every frame and is rebuilt in a private segment
+	virtual bool geometryKey(GeometryKey& key) const
+	{
+		return false;
+	}
+
+	bool changedIf(bool changed)
+	{
+		if (changed)
+			markChanged();
+		return changed;
+	}
+
+private:
+	void acquireSegment();
+
+private:
+	// shared segments are never written after they are built, an edit moves the path to another one
+	std::shared_ptr<PathSegment> mSegment;
+	uint32_t mSegmentVersion{0};
+	bool mIsSharedSegment{false};
 };
 
 struct VisibleComponent
@@ -39,6 +140,8 @@ struct VisibleComponent
 struct PathListComponent
 {
 	std::vector<std::unique_ptr<IPath>> paths;
+	// cached during playback, reset when paths are added or removed
+	ConstantRange constant;
 
 	PathListComponent();
 	~PathListComponent();
@@ -47,6 +150,34 @@ struct PathListComponent
 	PathListComponent& operator=(const PathListComponent&) = delete;
 	PathListComponent(PathListComponent&&) noexcept = default;
 	PathListComponent& operator=(PathListComponent&&) noexcept = default;
+
+	ConstantRange constantRange(float frameNo)
+	{
+		auto range = ConstantRange::All();
+		for (auto& path : paths)
+		{
+			range &= path->constantRange(frameNo);
+		}
+		return range;
+	}
+	size_t memoryUsage() const
+	{
+		size_t bytes = sizeof(*this) + paths.capacity() * sizeof(std::unique_ptr<IPath>);
+		for (const auto& path : paths)
+		{
+			bytes += path->memoryUsage();
+		}
+		return bytes;
+	}
+	size_t bakeMemoryUsage() const
+	{
+		size_t bytes = 0;
+		for (const auto& path : paths)
+		{
+			bytes += path->bakeMemoryUsage();
+		}
+		return bytes;
+	}
 };
 
 // shape
@@ -73,9 +204,43 @@ struct RectPath : public IPath
 		UPDATE_KEYFRAME(radiusKeyframes, radius, frameNo, changed);
 		UPDATE_KEYFRAME(positionKeyframes, position, frameNo, changed);
 		UPDATE_KEYFRAME(scaleKeyframes, scale, frameNo, changed);
-		return changed;
+		return changedIf(changed);
+	}
+	ConstantRange constantRange(float frameNo) override
+	{
+		auto range = ConstantRange::All();
+		range &= radiusKeyframes.constantRange(frameNo);
+		range &= positionKeyframes.constantRange(frameNo);
+		range &= scaleKeyframes.constantRange(frameNo);
+		return range;
+	}
+	void bake(uint32_t from, uint32_t to, BakeBudget& budget) override
+	{
+		radiusKeyframes.bake(from, to, budget);
+		positionKeyframes.bake(from, to, budget);
+		scaleKeyframes.bake(from, to, budget);
+	}
+
+	size_t memoryUsage() const override
+	{
+		return sizeof(*this) + radiusKeyframes.memoryUsage() + positionKeyframes.memoryUsage() +
+			   scaleKeyframes.memoryUsage();
+	}
+	size_t bakeMemoryUsage() const override
+	{
+		return radiusKeyframes.bakeMemoryUsage() + positionKeyframes.bakeMemoryUsage() +
+			   scaleKeyframes.bakeMemoryUsage();
+	}
+
+protected:
+	void build(PathSegment& segment) override;
+	bool geometryKey(GeometryKey& key) const override
+	{
+		if (radiusKeyframes.isEnable || positionKeyframes.isEnable || scaleKeyframes.isEnable)
+			return false;
+		key = {(int) Type::Rect, {radius, position.x, position.y, scale.x, scale.y}};
+		return true;
 	}
-	void appendTo(ShapeComponent& s) override;
 };
 
 struct EllipsePath : public IPath
@@ -98,15 +263,46 @@ struct EllipsePath : public IPath
 		bool changed = false;
 		UPDATE_KEYFRAME(positionKeyframes, position, frameNo, changed);
 		UPDATE_KEYFRAME(scaleKeyframes, scale, frameNo, changed);
-		return changed;
+		return changedIf(changed);
+	}
+	ConstantRange constantRange(float frameNo) override
+	{
+		auto range = ConstantRange::All();
+		range &= positionKeyframes.constantRange(frameNo);
+		range &= scaleKeyframes.constantRange(frameNo);
+		return range;
+	}
+	void bake(uint32_t from, uint32_t to, BakeBudget& budget) override
+	{
+		positionKeyframes.bake(from, to, budget);
+		scaleKeyframes.bake(from, to, budget);
+	}
+
+	size_t memoryUsage() const override
+	{
+		return sizeof(*this) + positionKeyframes.memoryUsage() + scaleKeyframes.memoryUsage();
+	}
+	size_t bakeMemoryUsage() const override
+	{
+		return positionKeyframes.bakeMemoryUsage() + scaleKeyframes.bakeMemoryUsage();
+	}
+
+protected:
+	void build(PathSegment& segment) override;
+	bool geometryKey(GeometryKey& key) const override
+	{
+		if (positionKeyframes.isEnable || scaleKeyframes.isEnable)
+			return false;
+		key = {(int) Type::Ellipse, {position.x, position.y, scale.x, scale.y}};
+		return true;
 	}
-	void appendTo(ShapeComponent& s) override;
 };
 
 struct RawPath : public IPath
 {
 	PathPoints path{};
 	Vec2 center{};
+	PathMorphKeyframes morphKeyframes;
 	RawPath() = default;
 	~RawPath() = default;
 	Type type() override
@@ -115,14 +311,20 @@ struct RawPath : public IPath
 	}
 	bool update(float frameNo) override
 	{
-		bool changed = false;
-		for (auto& p : path)
-		{
-			changed |= p.update(frameNo);
-		}
-		return changed;
+		return changedIf(morphKeyframes.frame(frameNo, path));
+	}
+	ConstantRange constantRange(float frameNo) override
+	{
+		return morphKeyframes.constantRange(frameNo);
+	}
+
+	size_t memoryUsage() const override
+	{
+		return sizeof(*this) + path.capacity() * sizeof(PathPoint) + morphKeyframes.memoryUsage();
 	}
-	void appendTo(ShapeComponent& s) override;
+
+protected:
+	void build(PathSegment& segment) override;
 };
 
 struct PolygonPath : public IPath
@@ -132,8 +334,6 @@ struct PolygonPath : public IPath
 	float outerRadius{100.0f};
 	Vec2 position{0.0f, 0.0f};
 
-	RawPath path;
-
 	IntegerKeyFrame pointsKeyframes;
 	FloatKeyFrame rotationKeyframes;
 	FloatKeyFrame outerRadiusKeyframes;
@@ -153,9 +353,46 @@ struct PolygonPath : public IPath
 		UPDATE_KEYFRAME(rotationKeyframes, rotation, frameNo, changed);
 		UPDATE_KEYFRAME(outerRadiusKeyframes, outerRadius, frameNo, changed);
 		UPDATE_KEYFRAME(positionKeyframes, position, frameNo, changed);
-		return changed;
+		return changedIf(changed);
+	}
+	ConstantRange constantRange(float frameNo) override
+	{
+		auto range = ConstantRange::All();
+		range &= pointsKeyframes.constantRange(frameNo);
+		range &= rotationKeyframes.constantRange(frameNo);
+		range &= outerRadiusKeyframes.constantRange(frameNo);
+		range &= positionKeyframes.constantRange(frameNo);
+		return range;
+	}
+	void bake(uint32_t from, uint32_t to, BakeBudget& budget) override
+	{
+		pointsKeyframes.bake(from, to, budget);
+		rotationKeyframes.bake(from, to, budget);
+		outerRadiusKeyframes.bake(from, to, budget);
+		positionKeyframes.bake(from, to, budget);
+	}
+
+	size_t memoryUsage() const override
+	{
+		return sizeof(*this) + pointsKeyframes.memoryUsage() + rotationKeyframes.memoryUsage() +
+			   outerRadiusKeyframes.memoryUsage() + positionKeyframes.memoryUsage();
+	}
+	size_t bakeMemoryUsage() const override
+	{
+		return pointsKeyframes.bakeMemoryUsage() + rotationKeyframes.bakeMemoryUsage() +
+			   outerRadiusKeyframes.bakeMemoryUsage() + positionKeyframes.bakeMemoryUsage();
+	}
+
+protected:
+	void build(PathSegment& segment) override;
+	// the generated outline depends on the point count and radius only
+	bool geometryKey(GeometryKey& key) const override
+	{
+		if (pointsKeyframes.isEnable || outerRadiusKeyframes.isEnable)
+			return false;
+		key = {(int) Type::Polygon, {(float) points, outerRadius}};
+		return true;
 	}
-	void appendTo(ShapeComponent& s) override;
 };
 
 struct StarPolygonPath : public IPath
@@ -166,8 +403,6 @@ struct StarPolygonPath : public IPath
 	float innerRadius{100.0f};
 	Vec2 position{0.0f, 0.0f};
 
-	RawPath path;
-
 	IntegerKeyFrame pointsKeyframes;
 	FloatKeyFrame rotationKeyframes;
 	FloatKeyFrame outerRadiusKeyframes;
@@ -189,9 +424,49 @@ struct StarPolygonPath : public IPath
 		UPDATE_KEYFRAME(outerRadiusKeyframes, outerRadius, frameNo, changed);
 		UPDATE_KEYFRAME(innerRadiusKeyframes, innerRadius, frameNo, changed);
 		UPDATE_KEYFRAME(positionKeyframes, position, frameNo, changed);
-		return changed;
+		return changedIf(changed);
+	}
+	ConstantRange constantRange(float frameNo) override
+	{
+		auto range = ConstantRange::All();
+		range &= pointsKeyframes.constantRange(frameNo);
+		range &= rotationKeyframes.constantRange(frameNo);
+		range &= outerRadiusKeyframes.constantRange(frameNo);
+		range &= innerRadiusKeyframes.constantRange(frameNo);
+		range &= positionKeyframes.constantRange(frameNo);
+		return range;
+	}
+	void bake(uint32_t from, uint32_t to, BakeBudget& budget) override
+	{
+		pointsKeyframes.bake(from, to, budget);
+		rotationKeyframes.bake(from, to, budget);
+		outerRadiusKeyframes.bake(from, to, budget);
+		innerRadiusKeyframes.bake(from, to, budget);
+		positionKeyframes.bake(from, to, budget);
+	}
+
+	size_t memoryUsage() const override
+	{
+		return sizeof(*this) + pointsKeyframes.memoryUsage() + rotationKeyframes.memoryUsage() +
+			   outerRadiusKeyframes.memoryUsage() + innerRadiusKeyframes.memoryUsage() +
+			   positionKeyframes.memoryUsage();
+	}
+	size_t bakeMemoryUsage() const override
+	{
+		return pointsKeyframes.bakeMemoryUsage() + rotationKeyframes.bakeMemoryUsage() +
+			   outerRadiusKeyframes.bakeMemoryUsage() + innerRadiusKeyframes.bakeMemoryUsage() +
+			   positionKeyframes.bakeMemoryUsage();
+	}
+
+protected:
+	void build(PathSegment& segment) override;
+	bool geometryKey(GeometryKey& key) const override
+	{
+		if (pointsKeyframes.isEnable || outerRadiusKeyframes.isEnable || innerRadiusKeyframes.isEnable)
+			return false;
+		key = {(int) Type::Star, {(float) points, outerRadius, innerRadius}};
+		return true;
 	}
-	void appendTo(ShapeComponent& s) override;
 };
 
 template <typename T>
@@ -0,0 +1,422 @@
+#include "pathSimplify.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace core
+{
+
+static constexpr int Count_FlattenStep = 8;
+static constexpr int Count_Reparameterize = 4;
+static constexpr float Cos_Corner = 0.5f;	 // turns sharper than 60 degrees keep a tangent break
+
+struct FitSegment
+{
+	Vec2 p0;
+	Vec2 c1;
+	Vec2 c2;
+	Vec2 p3;
+	bool isLine{false};
+};
+
+static Vec2 CubicAt(const Vec2& p0, const Vec2& c1, const Vec2& c2, const Vec2& p3, float t)
+{
+	const float mt = 1.0f - t;
+	return p0 * (mt * mt * mt) + c1 * (3.0f * mt * mt * t) + c2 * (3.0f * mt * t * t) + p3 * (t * t * t);
+}
+
+static Vec2 Normalized(const Vec2& v)
+{
+	const float len = std::sqrt(v * v);
+	return len > 1e-6f ? v / len : Vec2{0.0f, 0.0f};
+}
+
+static float Distance(const Vec2& a, const Vec2& b)
+{
+	const Vec2 d = a - b;
+	return std::sqrt(d * d);
+}
+
+static float DistanceToSegment(const Vec2& p, const Vec2& a, const Vec2& b)
+{
+	const Vec2 ab = b - a;
+	const float len2 = ab * ab;
+	const float t = len2 > 0.0f ? std::clamp(((p - a) * ab) / len2, 0.0f, 1.0f) : 0.0f;
+	return Distance(p, a + ab * t);
+}
+
+// one MoveTo at the start and at most one Close at the end
+static bool IsSinglePath(const PathPoints& points, bool& isClosed)
+{
+	isClosed = false;
+	for (size_t i = 1; i < points.size(); i++)
+	{
+		if (points[i].type == PathPoint::Command::MoveTo)
+			return false;
+		if (points[i].type == PathPoint::Command::Close)
+		{
+			if (i + 1 != points.size())
+				return false;
+			isClosed = true;
+		}
+	}
+	return true;
+}
+
+// polyline of the outline as it is drawn (see Build(PathSegment&, RawPath&)), a closed one ends on its first point
+static void Flatten(const PathPoints& points, bool isClosed, std::vector<Vec2>& out)
+{
+	auto addPoint = [&out](const Vec2& p)
+	{
+		if (out.empty() || Distance(p, out.back()) > 1e-6f)
+			out.push_back(p);
+	};
+	auto addCubic = [&addPoint](const Vec2& p0, const Vec2& c1, const Vec2& c2, const Vec2& p3)
+	{
+		for (int k = 1; k <= Count_FlattenStep; k++)
+		{
+			addPoint(CubicAt(p0, c1, c2, p3, static_cast<float>(k) / Count_FlattenStep));
+		}
+	};
+
+	const size_t count = isClosed ? points.size() - 1 : points.size();
+	addPoint(points[0].localPosition);
+	for (size_t i = 1; i < count; i++)
+	{
+		const auto& left = points[i - 1];
+		const auto& p = points[i];
+		if (p.type == PathPoint::Command::CubicTo)
+		{
+			addCubic(left.localPosition, left.localPosition + left.deltaRightControlPosition,
+					 p.localPosition + p.deltaLeftControlPosition, p.localPosition);
+		}
+		else
+		{
+			addPoint(p.localPosition);
+		}
+	}
+
+	if (isClosed)
+	{
+		const auto& left = points[count - 1];
+		const auto& right = points[0];
+		if (left.type == PathPoint::Command::CubicTo)
+		{
+			addCubic(left.localPosition, left.localPosition + left.deltaRightControlPosition,
+					 right.localPosition + right.deltaLeftControlPosition, right.localPosition);
+		}
+		if (Distance(out.back(), out.front()) > 1e-6f)
+		{
+			out.push_back(out.front());
+		}
+	}
+}
+
+// ramer-douglas-peucker, returns the largest distance of a removed point to the kept polyline
+static float Reduce(const std::vector<Vec2>& in, float tolerance, std::vector<Vec2>& out)
+{
+	std::vector<uint8_t> keep(in.size(), 0);
+	keep.front() = keep.back() = 1;
+
+	float maxError = 0.0f;
+	std::vector<std::pair<size_t, size_t>> stack{{0, in.size() - 1}};
+	while (!stack.empty())
+	{
+		const auto [first, last] = stack.back();
+		stack.pop_back();
+
+		float farthest = 0.0f;
+		size_t index = first;
+		for (size_t i = first + 1; i < last; i++)
+		{
+			const float d = DistanceToSegment(in[i], in[first], in[last]);
+			if (d > farthest)
+			{
+				farthest = d;
+				index = i;
+			}
+		}
+
+		if (farthest > tolerance)
+		{
+			keep[index] = 1;
+			stack.push_back({first, index});
+			stack.push_back({index, last});
+		}
+		else
+		{
+			maxError = std::max(maxError, farthest);
+		}
+	}
+
+	out.clear();
+	for (size_t i = 0; i < in.size(); i++)
+	{
+		if (keep[i])
+			out.push_back(in[i]);
+	}
+	return maxError;
+}
+
+// least-squares cubic fitting (schneider, graphics gems 1990).
+// tan1 points from the start into the curve, tan2 from the end back into the curve
+struct CubicFitter
+{
+	const std::vector<Vec2>& points;
+	float tolerance;
+	std::vector<FitSegment>& segments;
+	float maxError{0.0f};
+
+	CubicFitter(const std::vector<Vec2>& points, float tolerance, std::vector<FitSegment>& segments)
+		: points(points), tolerance(tolerance), segments(segments)
+	{
+	}
+
+	void fit(size_t first, size_t last, const Vec2& tan1, const Vec2& tan2)
+	{
+		const Vec2& p0 = points[first];
+		const Vec2& p3 = points[last];
+		if (last - first == 1)
+		{
+			segments.push_back({p0, p0, p3, p3, true});
+			return;
+		}
+
+		parameterize(first, last);
+		FitSegment curve = generate(first, last, tan1, tan2);
+		size_t split = first + 1;
+		float error = computeError(first, last, curve, split);
+		if (error > tolerance && error <= tolerance * 4.0f)
+		{
+			for (int n = 0; n < Count_Reparameterize && error > tolerance; n++)
+			{
+				reparameterize(first, last, curve);
+				curve = generate(first, last, tan1, tan2);
+				error = computeError(first, last, curve, split);
+			}
+		}
+
+		if (error <= tolerance)
+		{
+			segments.push_back(curve);
+			maxError = std::max(maxError, error);
+			return;
+		}
+
+		Vec2 center = Normalized(points[split - 1] - points[split + 1]);
+		if (center * center == 0.0f)
+			center = Normalized(points[split - 1] - points[split]);
+		fit(first, split, tan1, center);
+		fit(split, last, center * -1.0f, tan2);
+	}
+
+private:
+	void parameterize(size_t first, size_t last)
+	{
+		u.resize(last - first + 1);
+		u[0] = 0.0f;
+		for (size_t i = first + 1; i <= last; i++)
+		{
+			u[i - first] = u[i - first - 1] + Distance(points[i], points[i - 1]);
+		}
+		const float total = u.back();
+		for (auto& t : u)
+		{
+			t = total > 0.0f ? t / total : 0.0f;
+		}
+	}
+
+	FitSegment generate(size_t first, size_t last, const Vec2& tan1, const Vec2& tan2) const
+	{
+		const Vec2& p0 = points[first];
+		const Vec2& p3 = points[last];
+
+		float c00 = 0.0f, c01 = 0.0f, c11 = 0.0f, x0 = 0.0f, x1 = 0.0f;
+		for (size_t i = first; i <= last; i++)
+		{
+			const float t = u[i - first];
+			const float mt = 1.0f - t;
+			const float b0 = mt * mt * mt;
+			const float b1 = 3.0f * mt * mt * t;
+			const float b2 = 3.0f * mt * t * t;
+			const float b3 = t * t * t;
+			const Vec2 a1 = tan1 * b1;
+			const Vec2 a2 = tan2 * b2;
+			const Vec2 rest = points[i] - (p0 * (b0 + b1) + p3 * (b2 + b3));
+			c00 += a1 * a1;
+			c01 += a1 * a2;
+			c11 += a2 * a2;
+			x0 += a1 * rest;
+			x1 += a2 * rest;
+		}
+
+		const float det = c00 * c11 - c01 * c01;
+		float alpha1 = std::fabs(det) > 1e-12f ? (x0 * c11 - x1 * c01) / det : 0.0f;
+		float alpha2 = std::fabs(det) > 1e-12f ? (c00 * x1 - c01 * x0) / det : 0.0f;
+
+		// degenerate or flipped handles fall back to a third of the chord
+		const float chord = Distance(p0, p3);
+		if (alpha1 < chord * 1e-6f || alpha2 < chord * 1e-6f)
+		{
+			alpha1 = alpha2 = chord / 3.0f;
+		}
+		return {p0, p0 + tan1 * alpha1, p3 + tan2 * alpha2, p3, false};
+	}
+
+	float computeError(size_t first, size_t last, const FitSegment& curve, size_t& split) const
+	{
+		float maxDistance = 0.0f;
+		split = (first + last) / 2;
+		for (size_t i = first + 1; i < last; i++)
+		{
+			const float d = Distance(CubicAt(curve.p0, curve.c1, curve.c2, curve.p3, u[i - first]), points[i]);
+			if (d > maxDistance)
+			{
+				maxDistance = d;
+				split = i;
+			}
+		}
+		return maxDistance;
+	}
+
+	// one newton step per point towards the closest parameter on the curve
+	void reparameterize(size_t first, size_t last, const FitSegment& curve)
+	{
+		for (size_t i = first; i <= last; i++)
+		{
+			float& t = u[i - first];
+			const float mt = 1.0f - t;
+			const Vec2 q = CubicAt(curve.p0, curve.c1, curve.c2, curve.p3, t);
+			const Vec2 d1 = ((curve.c1 - curve.p0) * (mt * mt) + (curve.c2 - curve.c1) * (2.0f * mt * t) +
+							 (curve.p3 - curve.c2) * (t * t)) *
+							3.0f;
+			const Vec2 d2 = ((curve.c2 - curve.c1 * 2.0f + curve.p0) * mt + (curve.p3 - curve.c2 * 2.0f + curve.c1) * t) *
+							6.0f;
+			const Vec2 diff = q - points[i];
+			const float denominator = d1 * d1 + diff * d2;
+			if (std::fabs(denominator) > 1e-12f)
+			{
+				t = std::clamp(t - (diff * d1) / denominator, 0.0f, 1.0f);
+			}
+		}
+	}
+
+private:
+	std::vector<float> u;
+};
+
+PathSimplifyResult SimplifyPath(RawPath& path, float tolerance)
+{
+	auto& points = path.path;
+
+	PathSimplifyResult result;
+	result.inputPointCount = result.outputPointCount = points.size();
+
+	bool isClosed = false;
+	if (tolerance <= 0.0f || points.size() < 3 || path.morphKeyframes.isEnable || !IsSinglePath(points, isClosed))
+		return result;
+
+	std::vector<Vec2> dense;
+	Flatten(points, isClosed, dense);
+
+	// half of the tolerance is spent on the reduction, half on the fitting
+	std::vector<Vec2> reduced;
+	const float reduceError = dense.size() > 2 ? Reduce(dense, tolerance * 0.5f, reduced) : 0.0f;
+	if (reduced.size() < (isClosed ? 4u : 2u))
+		return result;
+
+	const size_t last = reduced.size() - 1;
+	auto direction = [&reduced](size_t from, size_t to) { return Normalized(reduced[to] - reduced[from]); };
+
+	// pieces are fitted between breaks: the ends, corners, and for a closed outline the point farthest from
+	// the start (so the loop is never a single segment). smooth breaks share a centered tangent
+	struct Break
+	{
+		size_t index;
+		bool isCorner;
+	};
+	std::vector<Break> breaks;
+	auto isCornerAt = [&](size_t prev, size_t i, size_t next)
+	{ return direction(prev, i) * direction(i, next) < Cos_Corner; };
+
+	size_t farthest = 1;
+	if (isClosed)
+	{
+		for (size_t i = 1; i < last; i++)
+		{
+			if (Distance(reduced[i], reduced[0]) > Distance(reduced[farthest], reduced[0]))
+				farthest = i;
+		}
+	}
+
+	breaks.push_back({0, isClosed ? isCornerAt(last - 1, 0, 1) : true});
+	for (size_t i = 1; i < last; i++)
+	{
+		const bool isCorner = isCornerAt(i - 1, i, i + 1);
+		if (isCorner || (isClosed && i == farthest))
+			breaks.push_back({i, isCorner});
+	}
+	breaks.push_back({last, breaks.front().isCorner});
+
+	auto startTangent = [&](const Break& b)
+	{
+		if (b.isCorner)
+			return direction(b.index, b.index + 1);
+		const size_t prev = b.index == 0 ? last - 1 : b.index - 1;
+		const size_t next = b.index == last ? 1 : b.index + 1;
+		return direction(prev, next);
+	};
+
+	std::vector<FitSegment> segments;
+	CubicFitter fitter{reduced, tolerance * 0.5f, segments};
+	for (size_t i = 0; i + 1 < breaks.size(); i++)
+	{
+		const auto& from = breaks[i];
+		const auto& to = breaks[i + 1];
+		const Vec2 tan2 = to.isCorner ? direction(to.index, to.index - 1) : startTangent(to) * -1.0f;
+		fitter.fit(from.index, to.index, startTangent(from), tan2);
+	}
+
+	PathPoints simplified;
+	simplified.reserve(segments.size() + 2);
+	simplified.push_back({.localPosition = segments.front().p0, .type = PathPoint::Command::MoveTo});
+	for (const auto& segment : segments)
+	{
+		PathPoint p{.localPosition = segment.p3, .type = PathPoint::Command::LineTo};
+		if (!segment.isLine)
+		{
+			simplified.back().deltaRightControlPosition = segment.c1 - segment.p0;
+			p.deltaLeftControlPosition = segment.c2 - segment.p3;
+			p.type = PathPoint::Command::CubicTo;
+		}
+		simplified.push_back(p);
+	}
+
+	if (isClosed)
+	{
+		// the last segment ends on the start point, Close draws it from the handles of the last and first point.
+		// a line stored as a cubic keeps zero handles, so it stays straight
+		const PathPoint closing = simplified.back();
+		simplified.pop_back();
+		if (closing.type == PathPoint::Command::CubicTo)
+		{
+			simplified.back().type = PathPoint::Command::CubicTo;
+			simplified.front().deltaLeftControlPosition = closing.deltaLeftControlPosition;
+		}
+		simplified.push_back({.type = PathPoint::Command::Close});
+	}
+
+	if (simplified.size() >= points.size())
+		return result;
+
+	points = std::move(simplified);
+	path.markChanged();
+
+	result.outputPointCount = points.size();
+	result.maxError = reduceError + fitter.maxError;
+	result.isSimplified = true;
+	return result;
+}
+
+}	 // namespace core
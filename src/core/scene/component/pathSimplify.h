@@ -0,0 +1,30 @@
+#ifndef _CORE_SCENE_COMPONENT_PATH_SIMPLIFY_H_
+#define _CORE_SCENE_COMPONENT_PATH_SIMPLIFY_H_
+
+#include "path.h"
+
+namespace core
+{
+
+struct PathSimplifyResult
+{
+	size_t inputPointCount{0};
+	size_t outputPointCount{0};
+	float maxError{0.0f};	 // largest measured distance between the input outline and the result
+	bool isSimplified{false};
+
+	float ratio() const
+	{
+		return inputPointCount > 0 ? static_cast<float>(outputPointCount) / inputPointCount : 1.0f;
+	}
+};
+
+// replaces a dense outline with a few cubic segments that stay within tolerance (in path-local units).
+// the outline is flattened, thinned with ramer-douglas-peucker, and then fitted with least-squares cubics
+// that are split at corners and wherever the fitting error exceeds the tolerance.
+// only single sub-path, non-animated paths are simplified; anything else is left unchanged
+PathSimplifyResult SimplifyPath(RawPath& path, float tolerance);
+
+}	 // namespace core
+
+#endif
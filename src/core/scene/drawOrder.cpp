@@ -0,0 +1,101 @@
+#include "drawOrder.h"
+
+namespace core
+{
+
+void DrawOrder::push(const Entity& entity)
+{
+	if (entity.mHandle == entt::null || contains(entity))
+		return;
+
+	const auto idx = ToIndex(entity);
+	if (idx >= mIndex.size())
+	{
+		mIndex.resize(idx + 1, mOrder.end());
+		mRank.resize(idx + 1, 0);
+	}
+	mIndex[idx] = mOrder.insert(mOrder.end(), entity);
+	mRank[idx] = ++mFrontRank;
+}
+
+bool DrawOrder::erase(const Entity& entity)
+{
+	auto it = find(entity);
+	if (it == mOrder.end())
+		return false;
+
+	mIndex[ToIndex(entity)] = mOrder.end();
+	mOrder.erase(it);
+	return true;
+}
+
+bool DrawOrder::contains(const Entity& entity) const
+{
+	return find(entity) != mOrder.end();
+}
+
+DrawOrder::Iterator DrawOrder::find(const Entity& entity)
+{
+	if (entity.mHandle == entt::null)
+		return mOrder.end();
+
+	const auto idx = ToIndex(entity);
+	if (idx >= mIndex.size() || mIndex[idx] == mOrder.end() || mIndex[idx]->mHandle != entity.mHandle)
+		return mOrder.end();
+
+	return mIndex[idx];
+}
+
+DrawOrder::ConstIterator DrawOrder::find(const Entity& entity) const
+{
+	return const_cast<DrawOrder*>(this)->find(entity);
+}
+
+bool DrawOrder::move(const Entity& entity, ChangeOrderType changeOrderType)
+{
+	auto it = find(entity);
+	if (it == mOrder.end() || mOrder.size() < 2)
+		return false;
+
+	// splice keeps every iterator valid, so the index does not need to be touched
+	switch (changeOrderType)
+	{
+		case ChangeOrderType::ToFront:
+		{
+			if (it == std::prev(mOrder.end()))
+				return false;
+			mOrder.splice(mOrder.end(), mOrder, it);
+			mRank[ToIndex(entity)] = ++mFrontRank;
+			break;
+		}
+		case ChangeOrderType::ToBack:
+		{
+			if (it == mOrder.begin())
+				return false;
+			mOrder.splice(mOrder.begin(), mOrder, it);
+			mRank[ToIndex(entity)] = --mBackRank;
+			break;
+		}
+		case ChangeOrderType::ToForward:
+		{
+			auto next = std::next(it);
+			if (next == mOrder.end())
+				return false;
+			std::swap(mRank[ToIndex(entity)], mRank[ToIndex(*next)]);
+			mOrder.splice(std::next(next), mOrder, it);
+			break;
+		}
+		case ChangeOrderType::ToBackward:
+		{
+			if (it == mOrder.begin())
+				return false;
+			auto prev = std::prev(it);
+			std::swap(mRank[ToIndex(entity)], mRank[ToIndex(*prev)]);
+			mOrder.splice(prev, mOrder, it);
+			break;
+		}
+	}
+	return true;
+}
+
+}	 // namespace core
@@ -0,0 +1,83 @@
+#ifndef _CORE_SCENE_DRAW_ORDER_H_
+#define _CORE_SCENE_DRAW_ORDER_H_
+
+#include "entity.h"
+
+#include <list>
+#include <vector>
+
+namespace core
+{
+
+// draw order of a scene (back to front)
+// the position of each entity is indexed by its registry slot, so find/move/erase are O(1)
+class DrawOrder
+{
+public:
+	using Container = std::list<Entity>;
+	using Iterator = Container::iterator;
+	using ConstIterator = Container::const_iterator;
+
+	void push(const Entity& entity);
+	bool erase(const Entity& entity);
+	bool contains(const Entity& entity) const;
+
+	// returns false if the position of the entity did not change
+	bool move(const Entity& entity, ChangeOrderType changeOrderType);
+
+	Iterator find(const Entity& entity);
+	ConstIterator find(const Entity& entity) const;
+
+	// position key, larger is drawn later (in front). only meaningful for entities in the order
+	int64_t rank(const Entity& entity) const
+	{
+		return mRank[ToIndex(entity)];
+	}
+
+	Iterator begin()
+	{
+		return mOrder.begin();
+	}
+	Iterator end()
+	{
+		return mOrder.end();
+	}
+	ConstIterator begin() const
+	{
+		return mOrder.begin();
+	}
+	ConstIterator end() const
+	{
+		return mOrder.end();
+	}
+	size_t size() const
+	{
+		return mOrder.size();
+	}
+	bool empty() const
+	{
+		return mOrder.empty();
+	}
+	const Container& list() const
+	{
+		return mOrder;
+	}
+
+private:
+	static size_t ToIndex(const Entity& entity)
+	{
+		return static_cast<size_t>(entt::to_entity(entity.mHandle));
+	}
+
+private:
+	Container mOrder;
+	std::vector<Iterator> mIndex;	 // registry slot -> position in mOrder (mOrder.end() if absent)
+	// registry slot -> rank, increasing along mOrder. moves only touch the moved entity (and a neighbour)
+	std::vector<int64_t> mRank;
+	int64_t mFrontRank{0};
+	int64_t mBackRank{0};
+};
+
+}	 // namespace core
+
+#endif
@@ -26,8 +26,6 @@ void Entity::setScaleByDelta(const Vec2& scaleDelta)
 void Entity::moveByDelta(const Vec2& delta)
 {
 	auto& transform = getComponent<TransformComponent>();
-	auto& worldtransform = getComponent<WorldTransformComponent>();
-	auto* pt = &transform;
 	transform.localPosition = transform.localPosition + delta;
 	updateTransform();
 	setDirty(Dirty::Type::Transform);
@@ -71,6 +69,14 @@ void Entity::setDirty(Dirty::Type dirtyType)
 
 	dirty.mask = dirty | dirtyType;
 	rScene->mIsDirty = true;
+
+	// changes that can move the bounds re-index the entity before the next pick
+	const auto boundsDirty =
+		Dirty::Type::Path | Dirty::Type::Transform | Dirty::Type::Stroke | Dirty::Type::AnimatedPath;
+	if ((static_cast<uint32_t>(dirtyType) & static_cast<uint32_t>(boundsDirty)) != 0)
+	{
+		rScene->mSpatialIndex.markDirty(mHandle);
+	}
 }
 void Entity::update()
 {
@@ -86,16 +92,15 @@ void Entity::updateShapePath()
 
 	auto& shape = getComponent<ShapeComponent>();
 
-	Reset(shape);
-
 	if (hasComponent<PathListComponent>())
 	{
-		auto& pathList = getComponent<PathListComponent>();
-		for (auto& path : pathList.paths)
-		{
-			path->appendTo(shape);
-		}
+		Update(shape, getComponent<PathListComponent>(), true);
+	}
+	else
+	{
+		Reset(shape);
 	}
+	rScene->mSpatialIndex.markDirty(mHandle);
 }
 
 bool Entity::updateShapePath(float keyframeNo)
@@ -112,8 +117,8 @@ bool Entity::updateShapePath(float keyframeNo)
 		for (auto& path : pathList.paths)
 		{
 			isChanged |= path->update(keyframeNo);
-			path->appendTo(shape);
 		}
+		Update(shape, pathList, false);
 	}
 	return isChanged;
 }
@@ -140,8 +145,9 @@ void Entity::updateTransform()
 	{
 		auto& shape = getComponent<ShapeComponent>();
 		UpdateShape<TransformComponent>(*this, shape);
+		rScene->mSpatialIndex.markDirty(mHandle);
 	}
-	getComponent<WorldTransformComponent>().update();
+	rScene->markWorldTransformDirty(*this);
 }
 
 const EntityID Entity::getId() const
@@ -27,6 +27,7 @@ struct Dirty
 		Fill = 1 << 2,
 		Stroke = 1 << 3,
 		Visible = 1 << 4,
+		AnimatedPath = 1 << 5,	  // keyframes changed some sub-paths, only those are rebuilt (Path rebuilds all)
 		All = 0xFFFF
 	};
 
@@ -0,0 +1,100 @@
+#include "entityIndex.h"
+
+#include "common/logger.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace core
+{
+
+std::array<EntityIndex*, EntityIndex::Count_Document> EntityIndex::gDocuments{};
+
+Entity EntityIndex::Find(EntityID id)
+{
+	if (auto* index = gDocuments[ToDocument(id)])
+	{
+		return index->find(id);
+	}
+	return Entity();
+}
+
+EntityIndex::EntityIndex()
+{
+	auto it = std::find(gDocuments.begin(), gDocuments.end(), nullptr);
+	if (it == gDocuments.end())
+	{
+		LOG_CRITICAL("EntityIndex: more than {} open documents", Count_Document);
+		std::abort();
+	}
+	mDocument = static_cast<uint32_t>(it - gDocuments.begin());
+	*it = this;
+}
+
+EntityIndex::~EntityIndex()
+{
+	gDocuments[mDocument] = nullptr;
+}
+
+EntityID EntityIndex::create(const Entity& entity)
+{
+	uint32_t slot = 0;
+	if (mFreeSlots.size() > Count_FreeSlotReserve || (mSlots.size() >= Count_Slot && !mFreeSlots.empty()))
+	{
+		slot = mFreeSlots.front();
+		mFreeSlots.pop_front();
+	}
+	else
+	{
+		if (mSlots.size() >= Count_Slot)
+		{
+			LOG_CRITICAL("EntityIndex: more than {} live entities in one document", Count_Slot);
+			std::abort();
+		}
+		slot = static_cast<uint32_t>(mSlots.size());
+		mSlots.emplace_back();
+	}
+
+	auto& s = mSlots[slot];
+	s.entity = entity;
+	return toId(slot, s.generation);
+}
+
+void EntityIndex::destroy(EntityID id)
+{
+	if (!valid(id))
+		return;
+
+	const auto slot = ToSlot(id);
+	auto& s = mSlots[slot];
+	s.entity = Entity();
+
+	// generation 0 is skipped so the id 0 stays invalid
+	s.generation = (s.generation + 1) & ((1u << Bits_Generation) - 1);
+	if (s.generation == 0)
+		s.generation = 1;
+	mFreeSlots.push_back(slot);
+}
+
+Entity EntityIndex::find(EntityID id) const
+{
+	if (!valid(id))
+		return Entity();
+	return mSlots[ToSlot(id)].entity;
+}
+
+bool EntityIndex::valid(EntityID id) const
+{
+	const auto slot = ToSlot(id);
+	return ToDocument(id) == mDocument && slot < mSlots.size() && mSlots[slot].generation == ToGeneration(id) &&
+		   !mSlots[slot].entity.isNull();
+}
+
+void EntityIndex::reserve(size_t count)
+{
+	const size_t reusable = mFreeSlots.size() > Count_FreeSlotReserve ? mFreeSlots.size() - Count_FreeSlotReserve : 0;
+	if (count > reusable)
+		mSlots.reserve(std::min<size_t>(mSlots.size() + count - reusable, Count_Slot));
+}
+
+}	 // namespace core
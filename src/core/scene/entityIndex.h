@@ -0,0 +1,85 @@
+#ifndef _CORE_SCENE_ENTITY_INDEX_H_
+#define _CORE_SCENE_ENTITY_INDEX_H_
+
+#include "entity.h"
+
+#include <array>
+#include <deque>
+#include <vector>
+
+namespace core
+{
+
+// dense, generation-checked EntityID -> Entity table of one document (a root scene and its child scenes).
+// an EntityID packs | document (4) | generation (7) | slot (20) |, so any id resolves with array lookups
+// and an id of a destroyed entity is detected as stale. 0 is never a valid id, and the top bit stays clear so
+// every id is positive as an ENTITY_ID (int) of the edit API.
+// freed slots are reused oldest first and only once Count_FreeSlotReserve others are waiting, so a stale id
+// aliases a live entity only after its slot went through the whole generation range.
+class EntityIndex
+{
+public:
+	static constexpr uint32_t Bits_Slot = 20;
+	static constexpr uint32_t Bits_Generation = 7;
+	static constexpr uint32_t Bits_Document = 4;
+	static constexpr uint32_t Count_Document = 1u << Bits_Document;
+	static constexpr uint32_t Count_Slot = 1u << Bits_Slot;
+	static constexpr size_t Count_FreeSlotReserve = 1024;
+	static_assert(Bits_Document + Bits_Generation + Bits_Slot <= 31, "ids must fit a positive int");
+
+	// the constructor and create abort when the document or slot range is exhausted, in every build type
+
+	// resolves the document from the id, returns a null Entity if the id is stale or unknown
+	static Entity Find(EntityID id);
+
+	EntityIndex();
+	~EntityIndex();
+	EntityIndex(const EntityIndex&) = delete;
+	EntityIndex& operator=(const EntityIndex&) = delete;
+
+	EntityID create(const Entity& entity);
+	void destroy(EntityID id);
+	Entity find(EntityID id) const;
+	bool valid(EntityID id) const;
+	void reserve(size_t count);
+
+	size_t size() const
+	{
+		return mSlots.size() - mFreeSlots.size();
+	}
+
+private:
+	struct Slot
+	{
+		Entity entity;
+		uint32_t generation{1};
+	};
+
+	static uint32_t ToSlot(EntityID id)
+	{
+		return id & ((1u << Bits_Slot) - 1);
+	}
+	static uint32_t ToGeneration(EntityID id)
+	{
+		return (id >> Bits_Slot) & ((1u << Bits_Generation) - 1);
+	}
+	static uint32_t ToDocument(EntityID id)
+	{
+		return (id >> (Bits_Slot + Bits_Generation)) & (Count_Document - 1);
+	}
+	EntityID toId(uint32_t slot, uint32_t generation) const
+	{
+		return (mDocument << (Bits_Slot + Bits_Generation)) | (generation << Bits_Slot) | slot;
+	}
+
+private:
+	static std::array<EntityIndex*, Count_Document> gDocuments;
+
+	uint32_t mDocument{0};
+	std::vector<Slot> mSlots;
+	std::deque<uint32_t> mFreeSlots;
+};
+
+}	 // namespace core
+
+#endif
@@ -9,6 +9,7 @@
 
 #include "ui/bbox.h"
 #include "canvas/shapeUtil.h"
+#include "common/threadPool.h"
 
 #include <thorvg.h>
 
@@ -18,13 +19,39 @@
 
 namespace core
 {
-std::unordered_map<tvg::Scene*, Scene*> Scene::gSceneMap;
-std::unordered_map<uint32_t, Entity> Scene::gEntityMap;
+static constexpr size_t Count_KeyframeEvaluationChunk = 256;
+static constexpr size_t Count_DestroyBatchRebuild = 64;
+// samples baked per update and scene, a larger bake is spread over the next updates
+static constexpr int64_t Count_BakeSamplePerUpdate = 1 << 16;
+
+
+// the paint that represents the entity inside the owner's tvg scene
+static tvg::Paint* GetPaint(Scene* owner, const Entity& entity)
+{
+	if (auto* scene = entity.tryGetComponent<SceneComponent>())
+	{
+		return owner != scene->scene ? scene->scene->getScene() : nullptr;
+	}
+	if (auto* shape = entity.tryGetComponent<ShapeComponent>())
+	{
+		return shape->shape;
+	}
+	return nullptr;
+}
 
 Scene::Scene(Scene* parentScene)
 {
 	Scene* targetScene = parentScene ? parentScene : this;
 	rParentScene = parentScene;
+	if (parentScene)
+	{
+		rEntityIndex = parentScene->rEntityIndex;
+	}
+	else
+	{
+		mEntityIndex = std::make_unique<EntityIndex>();
+		rEntityIndex = mEntityIndex.get();
+	}
 
 	auto entity = Scene::CreateEntity(targetScene, "Scene", parentScene ? parentScene->mSceneEntity : Entity());
 	auto& scene = entity.addComponent<SceneComponent>();
@@ -34,7 +61,6 @@ Scene::Scene(Scene* parentScene)
 	mTvgScene->ref();
 	mTvgScene->id = mId;
 	scene.scene = this;
-	gSceneMap[mTvgScene] = this;
 
 	mStorage.bind(mRegistry);
 	mStorage.on_update<Dirty>();
@@ -58,22 +84,18 @@ Scene::~Scene()
 
 Entity Scene::CreateEntity(Scene* scene, std::string_view name, Entity parent)
 {
-	static uint32_t id = 1;
-
 	Entity entity(scene);
 
-	entity.addComponent<IDComponent>(id);
-	auto& transform = entity.addComponent<TransformComponent>();
+	entity.addComponent<IDComponent>(scene->rEntityIndex->create(entity));
+	entity.addComponent<TransformComponent>();
 	entity.addComponent<WorldTransformComponent>(entity, parent);
+	AttachWorldTransform(entity);
+	UpdateWorldTransform(entity);
 	entity.addComponent<NameComponent>(name.empty() ? "Entity" : name);
 	entity.addComponent<RelationshipComponent>();
 	entity.addComponent<Dirty>();
 	entity.addComponent<VisibleComponent>();
-	scene->gEntityMap[id] = entity;
-
-	id++;
-
-	scene->mDrawOrder.push_back(entity);
+	scene->mDrawOrder.push(entity);
 
 	scene->mIsDirty = true;
 	entity.setDirty();
@@ -83,16 +105,22 @@ Entity Scene::CreateEntity(Scene* scene, std::string_view name, Entity parent)
 
 Scene* Scene::FindScene(tvg::Scene* scene)
 {
-	return gSceneMap[scene];
+	if (scene == nullptr)
+		return nullptr;
+
+	auto entity = FindEntity(scene->id);
+	if (entity.isNull())
+		return nullptr;
+
+	auto* component = entity.tryGetComponent<SceneComponent>();
+	if (component == nullptr || component->scene == nullptr || component->scene->getScene() != scene)
+		return nullptr;
+	return component->scene;
 }
 
 Entity Scene::FindEntity(uint32_t entityId)
 {
-	if (auto it = gEntityMap.find(entityId); it != gEntityMap.end())
-	{
-		return it->second;
-	}
-	return Entity();
+	return EntityIndex::Find(entityId);
 }
 
 std::unique_ptr<Scene> Scene::createScene()
@@ -105,29 +133,108 @@ Entity Scene::createEntity(std::string_view name)
 	return CreateEntity(this, name, mSceneEntity);
 }
 
-Entity Scene::createEllipseFillLayer(Vec2 minXy, Vec2 wh)
+// path of a primitive layer fitted to [minXy, minXy + wh], places the transform at its center
+static std::unique_ptr<IPath> CreatePrimitivePath(IPath::Type type, Vec2 minXy, Vec2 wh, TransformComponent& transform)
+{
+	transform.anchorPoint = {0.0f, 0.0f};
+	switch (type)
+	{
+		case IPath::Type::Ellipse:
+		{
+			auto ellipse = std::make_unique<EllipsePath>();
+			transform.localPosition = minXy + wh * 0.5f;
+			ellipse->scale = wh;
+			ellipse->position = {0.0f, 0.0f};
+			return ellipse;
+		}
+		case IPath::Type::Rect:
+		{
+			auto rect = std::make_unique<RectPath>();
+			transform.localPosition = minXy + wh * 0.5f;
+			rect->scale = wh;
+			rect->radius = 0.0f;
+			rect->position = {0.0f, 0.0f};
+			return rect;
+		}
+		case IPath::Type::Polygon:
+		{
+			auto polygon = std::make_unique<PolygonPath>();
+			const auto radius = wh.h / 2.0f;
+			polygon->points = CommonSetting::Count_DefaultPolygonPathPoint;
+			polygon->outerRadius = radius;
+			transform.localPosition = minXy + wh * 0.5f;
+			transform.scale.x = wh.w * 0.5f / radius;
+			return polygon;
+		}
+		case IPath::Type::Star:
+		{
+			if (wh.w * wh.h < 1e-6)
+			{
+				wh.w = wh.h = 1.0f;
+			}
+			auto star = std::make_unique<StarPolygonPath>();
+			const auto radius = wh.h / 2.0f;
+			star->points = CommonSetting::Count_DefaultStarPolygonPathPoint;
+			star->outerRadius = radius;
+			star->innerRadius = radius / 2.0f;
+			transform.localPosition = minXy + wh * 0.5f;
+			transform.scale.x = wh.w * 0.5f / radius;
+			return star;
+		}
+		default:
+			return nullptr;
+	}
+}
+
+static std::string_view GetLayerName(IPath::Type type)
+{
+	switch (type)
+	{
+		case IPath::Type::Ellipse:
+			return "Ellipse Layer";
+		case IPath::Type::Rect:
+			return "Rect Layer";
+		case IPath::Type::Polygon:
+			return "Polygon Layer";
+		case IPath::Type::Star:
+			return "Star Layer";
+		default:
+			return "Path Layer";
+	}
+}
+
+template <typename... TComponents>
+static void ReserveStorage(entt::registry& registry, size_t count)
+{
+	(registry.storage<TComponents>().reserve(registry.storage<TComponents>().size() + count), ...);
+}
+
+Entity Scene::createPrimitiveLayer(IPath::Type type, Vec2 minXy, Vec2 wh)
 {
-	auto entity = CreateEntity(this, "Ellipse Layer", mSceneEntity);
+	auto entity = CreateEntity(this, GetLayerName(type), mSceneEntity);
 	auto& id = entity.getComponent<IDComponent>();
 	auto& transform = entity.getComponent<TransformComponent>();
 	auto& pathList = entity.addComponent<PathListComponent>();
 	auto& shape = entity.addComponent<ShapeComponent>();
 	entity.addComponent<SolidFillComponent>();
-	auto ellipse = std::make_unique<EllipsePath>();
 
-	transform.localPosition = minXy + wh * 0.5f;
-	transform.anchorPoint = {0.0f, 0.0f};
-	ellipse->scale = wh;
-	ellipse->position = {0.0f, 0.0f};
-
-	// push shape
 	shape.shape = tvg::Shape::gen();
 	shape.shape->id = id.id;
 	shape.shape->ref();
 
-	pathList.paths.push_back(std::move(ellipse));
+	if (auto path = CreatePrimitivePath(type, minXy, wh, transform))
+	{
+		pathList.paths.push_back(std::move(path));
+	}
+
+	return entity;
+}
+
+Entity Scene::createEllipseFillLayer(Vec2 minXy, Vec2 wh)
+{
+	auto entity = createPrimitiveLayer(IPath::Type::Ellipse, minXy, wh);
 	entity.update();
-	mTvgScene->push(shape.shape);
+	mTvgScene->push(entity.getComponent<ShapeComponent>().shape);
 
 	return entity;
 }
@@ -142,28 +249,9 @@ Entity Scene::createEllipseFillStrokeLayer(Vec2 minXy, Vec2 wh)
 
 Entity Scene::createRectFillLayer(Vec2 minXy, Vec2 wh)
 {
-	auto entity = CreateEntity(this, "Rect Layer", mSceneEntity);
-	auto& id = entity.getComponent<IDComponent>();
-	auto& transform = entity.getComponent<TransformComponent>();
-	auto& pathList = entity.addComponent<PathListComponent>();
-	auto rect = std::make_unique<RectPath>();
-	auto& shape = entity.addComponent<ShapeComponent>();
-	entity.addComponent<SolidFillComponent>();
-
-	transform.localPosition = minXy + wh * 0.5f;
-	transform.anchorPoint = {0.0f, 0.0f};
-	rect->scale = wh;
-	rect->radius = 0.0f;
-	rect->position = {0.0f, 0.0f};
-
-	// push shape
-	shape.shape = tvg::Shape::gen();
-	shape.shape->id = id.id;
-	shape.shape->ref();
-
-	pathList.paths.push_back(std::move(rect));
+	auto entity = createPrimitiveLayer(IPath::Type::Rect, minXy, wh);
 	entity.update();
-	mTvgScene->push(shape.shape);
+	mTvgScene->push(entity.getComponent<ShapeComponent>().shape);
 
 	return entity;
 }
@@ -177,30 +265,9 @@ Entity Scene::createRectFillStrokeLayer(Vec2 minXy, Vec2 wh)
 
 Entity Scene::createPolygonFillLayer(Vec2 minXy, Vec2 wh)
 {
-	auto entity = CreateEntity(this, "Polygon Layer", mSceneEntity);
-	auto& transform = entity.getComponent<TransformComponent>();
-	auto& id = entity.getComponent<IDComponent>();
-	auto& shape = entity.addComponent<ShapeComponent>();
-	auto& pathList = entity.addComponent<PathListComponent>();
-	auto polygon = std::make_unique<PolygonPath>();
-
-	entity.addComponent<SolidFillComponent>();
-
-	const auto radius = wh.h / 2.0f;
-	polygon->points = CommonSetting::Count_DefaultPolygonPathPoint;
-	polygon->outerRadius = radius;
-
-	transform.anchorPoint = {0.0f, 0.0f};
-	transform.localPosition = polygon->path.center = minXy + wh * 0.5f;
-	transform.scale.x = wh.w * 0.5f / radius;
-
-	shape.shape = tvg::Shape::gen();
-	shape.shape->ref();
-	shape.shape->id = id.id;
-
-	pathList.paths.push_back(std::move(polygon));
+	auto entity = createPrimitiveLayer(IPath::Type::Polygon, minXy, wh);
 	entity.update();
-	mTvgScene->push(shape.shape);
+	mTvgScene->push(entity.getComponent<ShapeComponent>().shape);
 
 	return entity;
 }
@@ -214,37 +281,43 @@ Entity Scene::createPolygonFillStrokeLayer(Vec2 minXy, Vec2 wh)
 
 Entity Scene::createStarFillLayer(Vec2 minXy, Vec2 wh)
 {
-	if (wh.w * wh.h < 1e-6)
-	{
-		wh.w = wh.h = 1.0f;
-	}
-	auto entity = CreateEntity(this, "Star Layer", mSceneEntity);
-	auto& transform = entity.getComponent<TransformComponent>();
-	auto& id = entity.getComponent<IDComponent>();
-	auto& shape = entity.addComponent<ShapeComponent>();
-	auto& pathList = entity.addComponent<PathListComponent>();
-	auto star = std::make_unique<StarPolygonPath>();
-
-	entity.addComponent<SolidFillComponent>();
-
-	const auto radius = wh.h / 2.0f;
-	star->points = CommonSetting::Count_DefaultStarPolygonPathPoint;
-	star->outerRadius = radius;
-	star->innerRadius = radius / 2.0f;
+	auto entity = createPrimitiveLayer(IPath::Type::Star, minXy, wh);
+	entity.update();
+	mTvgScene->push(entity.getComponent<ShapeComponent>().shape);
 
-	transform.anchorPoint = {0.0f, 0.0f};
-	star->path.center = transform.localPosition = minXy + wh * 0.5f;
-	transform.scale.x = wh.w * 0.5f / radius;
+	return entity;
+}
 
-	shape.shape = tvg::Shape::gen();
-	shape.shape->ref();
-	shape.shape->id = id.id;
+std::vector<Entity> Scene::createLayers(const LayerDescriptor* descriptors, size_t count)
+{
+	std::vector<Entity> entities;
+	entities.reserve(count);
+
+	rEntityIndex->reserve(count);
+	ReserveStorage<entt::entity, IDComponent, TransformComponent, WorldTransformComponent, NameComponent,
+				   RelationshipComponent, Dirty, VisibleComponent, PathListComponent, ShapeComponent,
+				   SolidFillComponent>(mRegistry, count);
+	auto& children = mSceneEntity.getComponent<WorldTransformComponent>().children;
+	children.reserve(children.size() + count);
+
+	// the entities are created dirty, so the next onUpdate builds transform, path and attributes in one pass
+	for (size_t i = 0; i < count; i++)
+	{
+		const auto& desc = descriptors[i];
+		auto entity = createPrimitiveLayer(desc.type, desc.minXy, desc.wh);
+		if (desc.hasStroke)
+		{
+			entity.addComponent<StrokeComponent>();
+		}
+		entities.push_back(entity);
+	}
 
-	pathList.paths.push_back(std::move(star));
-	entity.update();
-	mTvgScene->push(shape.shape);
+	for (auto& entity : entities)
+	{
+		mTvgScene->push(entity.getComponent<ShapeComponent>().shape);
+	}
 
-	return entity;
+	return entities;
 }
 
 Entity Scene::createPathLayer(PathPoints path)
@@ -285,17 +358,9 @@ Entity Scene::createPathLayer(PathPoints path)
 	return entity;
 }
 
-Entity Scene::createObb(const std::array<Vec2, 4>& points)
+// outline of an obb through points, centered on the transform of its entity
+static void SetObbPath(TransformComponent& transform, RawPath& rawPath, const std::array<Vec2, 4>& points)
 {
-	auto entity = CreateEntity(this, "obb", mSceneEntity);
-
-	auto& transform = entity.getComponent<TransformComponent>();
-	auto& id = entity.getComponent<IDComponent>();
-	auto& shape = entity.addComponent<ShapeComponent>();
-	auto& stroke = entity.addComponent<StrokeComponent>();
-	auto& pathList = entity.addComponent<PathListComponent>();
-	auto rawPath = std::make_unique<RawPath>();
-
 	auto minx = std::min({points[0].x, points[1].x, points[2].x, points[3].x});
 	auto maxx = std::max({points[0].x, points[1].x, points[2].x, points[3].x});
 	auto miny = std::min({points[0].y, points[1].y, points[2].y, points[3].y});
@@ -308,18 +373,31 @@ Entity Scene::createObb(const std::array<Vec2, 4>& points)
 	transform.localPosition = {minx + width * 0.5f, miny + height * 0.5f};
 
 	auto centerp = transform.localPosition;
-	rawPath->path.resize(5);
-	rawPath->path[0].type = PathPoint::Command::MoveTo;
-	rawPath->path[1].type = PathPoint::Command::LineTo;
-	rawPath->path[2].type = PathPoint::Command::LineTo;
-	rawPath->path[3].type = PathPoint::Command::LineTo;
-	rawPath->path[4].type = PathPoint::Command::Close;
-	rawPath->center = Vec2{width / 2, height / 2};
+	rawPath.path.resize(5);
+	rawPath.path[0].type = PathPoint::Command::MoveTo;
+	rawPath.path[1].type = PathPoint::Command::LineTo;
+	rawPath.path[2].type = PathPoint::Command::LineTo;
+	rawPath.path[3].type = PathPoint::Command::LineTo;
+	rawPath.path[4].type = PathPoint::Command::Close;
+	rawPath.center = Vec2{width / 2, height / 2};
 
 	for (int i = 0; i < 4; i++)
 	{
-		rawPath->path[i].localPosition = points[i] - centerp;
+		rawPath.path[i].localPosition = points[i] - centerp;
 	}
+}
+
+Entity Scene::createObb(const std::array<Vec2, 4>& points)
+{
+	auto entity = CreateEntity(this, "obb", mSceneEntity);
+
+	auto& transform = entity.getComponent<TransformComponent>();
+	auto& id = entity.getComponent<IDComponent>();
+	auto& shape = entity.addComponent<ShapeComponent>();
+	auto& stroke = entity.addComponent<StrokeComponent>();
+	auto& pathList = entity.addComponent<PathListComponent>();
+	auto rawPath = std::make_unique<RawPath>();
+	SetObbPath(transform, *rawPath, points);
 
 	shape.shape = tvg::Shape::gen();
 	shape.shape->ref();
@@ -332,35 +410,38 @@ Entity Scene::createObb(const std::array<Vec2, 4>& points)
 	return entity;
 }
 
+void Scene::updateObb(Entity& entity, const std::array<Vec2, 4>& points)
+{
+	auto& rawPath = static_cast<RawPath&>(*entity.getComponent<PathListComponent>().paths[0]);
+	SetObbPath(entity.getComponent<TransformComponent>(), rawPath, points);
+	rawPath.markChanged();
+	entity.setDirty(Dirty::Type::Transform | Dirty::Type::Path);
+}
+
 Entity Scene::getEntityById(uint32_t id)
 {
-	auto it = gEntityMap.find(id);
-	assert(it != gEntityMap.end());
-	return it->second;
+	auto entity = rEntityIndex->find(id);
+	assert(!entity.isNull());
+	return entity;
 }
 Entity Scene::tryGetEntityById(uint32_t id)
 {
-	auto it = gEntityMap.find(id);
-	if (it == gEntityMap.end())
-		return Entity();
-	return it->second;
+	return rEntityIndex->find(id);
 }
 
 void Scene::destroyEntity(Entity& entity)
 {
-	mDrawOrder.erase(std::remove_if(mDrawOrder.begin(), mDrawOrder.end(),
-									[&entity](Entity& a) { return entity.getId() == a.getId(); }));
-
-	// LOG_INFO("Destroying entity: {}", entity.getComponent<IDComponent>().id);
-	if (entity.hasComponent<ShapeComponent>())
+	if (entity.isNull() || entity.hasComponent<DestroyState>())
 	{
-		auto& shape = entity.getComponent<ShapeComponent>();
-		mTvgScene->remove(shape.shape);
-		shape.shape->unref();
-		entity.removeComponent<ShapeComponent>();
+		entity.mHandle = entt::null;
+		return;
 	}
-	gEntityMap.erase(entity.getComponent<IDComponent>().id);
-	entity.getOrAddComponent<DestroyState>();
+
+	// LOG_INFO("Destroying entity: {}", entity.getComponent<IDComponent>().id);
+	mDrawOrder.erase(entity);
+	mSpatialIndex.remove(entity.mHandle);
+	entity.addComponent<DestroyState>();
+	mDestroyQueue.push_back(entity.mHandle);
 
 	entity.mHandle = entt::null;
 	mIsDirty = true;
@@ -411,155 +492,249 @@ void Scene::reorder()
 
 void Scene::changeDrawOrder(const Entity& entity, ChangeOrderType changeOrderType)
 {
-	auto it = std::find(mDrawOrder.begin(), mDrawOrder.end(), entity);
-	if (it == mDrawOrder.end() || mDrawOrder.size() < 2)
+	if (!mDrawOrder.move(entity, changeOrderType))
+		return;
+
+	auto* paint = GetPaint(this, entity);
+	if (paint == nullptr)
 		return;
 
-	switch (changeOrderType)
+	// re-link only the moved paint: insert it before the next entity that owns a paint
+	tvg::Paint* at = nullptr;
+	for (auto it = std::next(mDrawOrder.find(entity)); it != mDrawOrder.end() && at == nullptr; ++it)
 	{
-		case ChangeOrderType::ToFront:
-		{
-			auto last = std::prev(mDrawOrder.end());
-			if (it == last)
-				return;
-			mDrawOrder.splice(mDrawOrder.end(), mDrawOrder, it);
-			break;
-		}
-		case ChangeOrderType::ToBack:
-		{
-			if (it == mDrawOrder.begin())
-				return;
-			mDrawOrder.splice(mDrawOrder.begin(), mDrawOrder, it);
-			break;
-		}
-		case ChangeOrderType::ToForward:
-		{
-			auto next = std::next(it);
-			if (next == mDrawOrder.end())
-				return;
-			mDrawOrder.splice(std::next(next), mDrawOrder, it);
-			break;
-		}
-		case ChangeOrderType::ToBackward:
-		{
-			if (it == mDrawOrder.begin())
-				return;
-			auto prev = std::prev(it);
-			mDrawOrder.splice(prev, mDrawOrder, it);
-			break;
-		}
+		at = GetPaint(this, *it);
 	}
 
-	reorder();
+	mTvgScene->remove(paint);
+	mTvgScene->push(paint, at);
+	mIsDirty = true;
 }
-bool Scene::onUpdate()
+template <typename... TComponents, typename Func>
+void Scene::evaluateKeyframes(Dirty::Type dirtyType, Func func)
 {
-	// todo: this canvas maybe no scene owner (current canvas count == 1)
-	auto* canvasPtr = GetCurrentAnimCanvas();
-
-	mRegistry.view<BBoxControlComponent>().each([](auto entity, BBoxControlComponent& bbox) { bbox.bbox->onUpdate(); });
+	auto view = mRegistry.view<TComponents...>();
+	mEvalEntities.assign(view.begin(), view.end());
+	mEvalChanged.assign(mEvalEntities.size(), 0);
+
+	// each chunk reads only its own components and writes only its own flags, so mStorage is untouched here
+	ThreadPool::Get().parallelFor(mEvalEntities.size(), Count_KeyframeEvaluationChunk,
+								  [&](size_t begin, size_t end)
+								  {
+									  for (size_t i = begin; i < end; i++)
+									  {
+										  mEvalChanged[i] = func(view.template get<TComponents>(mEvalEntities[i])...);
+									  }
+								  });
+
+	// merged in view order, same as the serial loop
+	for (size_t i = 0; i < mEvalEntities.size(); i++)
+	{
+		if (mEvalChanged[i])
+			Entity(this, (uint32_t) mEvalEntities[i]).setDirty(dirtyType);
+	}
+}
 
-	auto* animCanvas = static_cast<AnimationCreatorCanvas*>(canvasPtr);
-	auto* animator = animCanvas->mAnimator.get();
-	const auto keyframeNo = animator->mCurrentFrameNo;
-	bool isStop = animator->mIsStop;
+// during playback a component is evaluated only when the playhead leaves the cached range
+// over which all of its tracks are constant. most layers of a document are still at any given frame
+template <typename TKeyframes, typename Func>
+static bool UpdateUnlessConstant(TKeyframes& keyframes, float frameNo, bool isPlaying, Func evaluate)
+{
+	if (!isPlaying)
+		return evaluate();
+	if (keyframes.constant.contains(frameNo))
+		return false;
+
+	const bool isChanged = evaluate();
+	keyframes.constant = keyframes.constantRange(frameNo);
+	return isChanged;
+}
 
-	mRegistry.view<TransformComponent, TransformKeyframeComponent>().each(
-		[keyframeNo, scene = this](auto entity, TransformComponent& transform, TransformKeyframeComponent& keyframes)
-		{
-			if (keyframes.update(keyframeNo, transform))
-			{
-				Entity(scene, (uint32_t) entity).setDirty(core::Dirty::Type::Transform);
-			}
-		});
+template <typename TComponent, typename Func>
+void Scene::bakeKeyframes(Func func)
+{
+	auto view = mRegistry.view<TComponent>();
+	mEvalEntities.assign(view.begin(), view.end());
+
+	// each track is written only by the chunk that owns its entity, the budget is shared
+	ThreadPool::Get().parallelFor(mEvalEntities.size(), Count_KeyframeEvaluationChunk,
+								  [&](size_t begin, size_t end)
+								  {
+									  for (size_t i = begin; i < end; i++)
+									  {
+										  func(view.template get<TComponent>(mEvalEntities[i]));
+									  }
+								  });
+}
 
-	// if (!isStop)
+void Scene::updateKeyframes(const Animator& animator)
+{
+	const auto keyframeNo = animator.mCurrentFrameNo;
+	bool isStop = animator.mIsStop;
+
+	// tracks edited since the last bake (or never baked) are interpolated until they are baked again.
+	// once a walk bakes every track, the walks are skipped until a key is edited or the range changes
+	const uint32_t from = animator.mMinFrameNo;
+	const uint32_t to = animator.mMaxFrameNo;
+	const bool isBaked = mBakedRevision == gKeyframeRevision && mBakedFrom == from && mBakedTo == to &&
+						 mIsBakedQuantized == animator.mIsQuantizeBake;
+	if (animator.mIsBake && !isBaked)
 	{
-		mRegistry.view<PathListComponent>().each(
-			[keyframeNo, scene = this](auto entity, PathListComponent& path)
+		const uint32_t revision = gKeyframeRevision;
+		BakeBudget budget;
+		budget.samples = Count_BakeSamplePerUpdate;
+		budget.isQuantized = animator.mIsQuantizeBake;
+		bakeKeyframes<TransformKeyframeComponent>([&](TransformKeyframeComponent& keyframes)
+												  { keyframes.bake(from, to, budget); });
+		bakeKeyframes<PathListComponent>(
+			[&](PathListComponent& pathList)
 			{
-				bool isChanged = false;
-				for (auto& p : path.paths)
+				for (auto& path : pathList.paths)
 				{
-					isChanged |= p->update(keyframeNo);
+					path->bake(from, to, budget);
 				}
-				if (isChanged)
-					Entity(scene, (uint32_t) entity).setDirty(core::Dirty::Type::Path);
-			});
-		mRegistry.view<SolidFillComponent>().each(
-			[keyframeNo, scene = this](auto entity, SolidFillComponent& fill)
-			{
-				if (fill.update(keyframeNo))
-					Entity(scene, (uint32_t) entity).setDirty(core::Dirty::Type::Fill);
 			});
+		bakeKeyframes<SolidFillComponent>([&](SolidFillComponent& fill) { fill.bake(from, to, budget); });
+		bakeKeyframes<StrokeComponent>([&](StrokeComponent& stroke) { stroke.bake(from, to, budget); });
+
+		// a track skipped for lack of budget leaves the count negative
+		if (budget.samples.load(std::memory_order_relaxed) >= 0)
+		{
+			mBakedRevision = revision;
+			mBakedFrom = from;
+			mBakedTo = to;
+			mIsBakedQuantized = animator.mIsQuantizeBake;
+		}
+	}
+
+	// the tracks are evaluated once per clock step while playing, not once per display refresh.
+	// a stopped animator is evaluated again only after a scrub or a key edit (gKeyframeRevision)
+	const bool isEdited = mEvaluatedRevision != gKeyframeRevision || animator.mDirty;
+	if (keyframeNo != mEvaluatedFrameNo || (isStop && isEdited))
+	{
+		mEvaluatedFrameNo = keyframeNo;
+		mEvaluatedRevision = gKeyframeRevision;
 
-		mRegistry.view<StrokeComponent>().each(
-			[keyframeNo, scene = this](auto entity, StrokeComponent& stroke)
+		const bool isPlaying = !isStop;
+		evaluateKeyframes<TransformComponent, TransformKeyframeComponent>(
+			Dirty::Type::Transform,
+			[keyframeNo, isPlaying](TransformComponent& transform, TransformKeyframeComponent& keyframes)
 			{
-				if (stroke.update(keyframeNo))
-					Entity(scene, (uint32_t) entity).setDirty(core::Dirty::Type::Stroke);
+				return UpdateUnlessConstant(keyframes, keyframeNo, isPlaying,
+											[&] { return keyframes.update(keyframeNo, transform); });
 			});
+		evaluateKeyframes<PathListComponent>(Dirty::Type::AnimatedPath,
+											 [keyframeNo, isPlaying](PathListComponent& path)
+											 {
+												 return UpdateUnlessConstant(path, keyframeNo, isPlaying,
+																			 [&]
+																			 {
+																				 bool isChanged = false;
+																				 for (auto& p : path.paths)
+																				 {
+																					 isChanged |= p->update(keyframeNo);
+																				 }
+																				 return isChanged;
+																			 });
+											 });
+		evaluateKeyframes<SolidFillComponent>(Dirty::Type::Fill,
+											  [keyframeNo, isPlaying](SolidFillComponent& fill)
+											  {
+												  return UpdateUnlessConstant(fill, keyframeNo, isPlaying,
+																			  [&] { return fill.update(keyframeNo); });
+											  });
+		evaluateKeyframes<StrokeComponent>(Dirty::Type::Stroke,
+										   [keyframeNo, isPlaying](StrokeComponent& stroke)
+										   {
+											   return UpdateUnlessConstant(stroke, keyframeNo, isPlaying,
+																		   [&] { return stroke.update(keyframeNo); });
+										   });
 	}
+}
 
-	for (auto& entity : mStorage)
+bool Scene::onUpdate()
+{
+	// todo: this canvas maybe no scene owner (current canvas count == 1)
+	auto* canvasPtr = GetCurrentAnimCanvas();
+
+	mRegistry.view<BBoxControlComponent>().each([](auto entity, BBoxControlComponent& bbox) { bbox.bbox->onUpdate(); });
+
+	// without an animation canvas (e.g. a headless scene) there is no timeline to evaluate
+	if (auto* animCanvas = static_cast<AnimationCreatorCanvas*>(canvasPtr))
 	{
-		auto& dirty = mRegistry.get<Dirty>(entity);
-		auto e = Entity(this, (uint32_t) entity);
+		updateKeyframes(*animCanvas->mAnimator);
+	}
 
-		if (e.hasComponent<DestroyState>())
+	for (auto& entity : mStorage)
+	{
+		if (mRegistry.all_of<DestroyState>(entity))
 		{
 			continue;
 		}
 
-		if (e.hasComponent<ShapeComponent>())
+		// one lookup per component instead of hasComponent + getComponent
+		auto& dirty = mRegistry.get<Dirty>(entity);
+		auto& transform = mRegistry.get<TransformComponent>(entity);
+		auto [shape, visible, pathList, fill, stroke, scene] =
+			mRegistry.try_get<ShapeComponent, VisibleComponent, PathListComponent, SolidFillComponent, StrokeComponent,
+							  SceneComponent>(entity);
+
+		if (shape)
 		{
-			auto& visible = e.getComponent<VisibleComponent>();
-			auto& shape = e.getComponent<ShapeComponent>();
 			if (HasDirty(dirty, Dirty::Type::Transform))
 			{
-				Update(shape, e.getComponent<TransformComponent>());
+				Update(*shape, transform);
 			}
-			if (HasDirty(dirty, Dirty::Type::Path) || HasDirty(dirty, Dirty::Type::Fill) ||
-				HasDirty(dirty, Dirty::Type::Stroke) || HasDirty(dirty, Dirty::Type::Visible))
+			const bool isPathDirty = HasDirty(dirty, Dirty::Type::Path) || HasDirty(dirty, Dirty::Type::AnimatedPath);
+			if (isPathDirty || HasDirty(dirty, Dirty::Type::Fill) || HasDirty(dirty, Dirty::Type::Stroke) ||
+				HasDirty(dirty, Dirty::Type::Visible))
 			{
-				bool isPathUpdate = true;
-				if (e.getComponent<PathListComponent>().paths.empty() && visible.isVisible)
+				bool isPathUpdate = isPathDirty;
+				if (pathList->paths.empty() && visible->isVisible)
 				{
 					isPathUpdate = false;
-					shape.shape->visible(false);
+					shape->shape->visible(false);
 				}
-				else if (visible.isVisible && !shape.shape->visible())
+				else if (visible->isVisible && !shape->shape->visible())
 				{
-					shape.shape->visible(true);
+					shape->shape->visible(true);
 				}
 				else if (HasDirty(dirty, Dirty::Type::Visible))
 				{
-					shape.shape->visible(visible.isVisible);
+					shape->shape->visible(visible->isVisible);
 				}
 
+				// the tvg shape keeps its path until reset, so only a path change rebuilds it.
+				// edits bump the version of the sub-paths they change (markChanged), the others keep their segment
 				if (isPathUpdate)
-					e.updateShapePath();
+				{
+					Update(*shape, *pathList, false);
+				}
 
-				if (e.hasComponent<SolidFillComponent>())
+				// attributes that did not change are skipped inside Update
+				if (fill)
 				{
-					Update(shape, e.getComponent<SolidFillComponent>());
+					Update(*shape, *fill);
 				}
-				if (e.hasComponent<StrokeComponent>())
+				if (stroke)
 				{
-					Update(shape, e.getComponent<StrokeComponent>());
+					Update(*shape, *stroke);
 				}
 			}
 		}
-		if (e.hasComponent<SceneComponent>())
+		if (scene)
 		{
-			Update(e.getComponent<SceneComponent>(), e.getComponent<TransformComponent>());
+			Update(*scene, transform);
+		}
+		if (HasDirty(dirty, Dirty::Type::Transform))
+		{
+			markWorldTransformDirty(Entity(this, (uint32_t) entity));
 		}
 
 		dirty.mask = Dirty::Type::None;
 	}
 
-	mRegistry.view<WorldTransformComponent>().each([this](auto entity, WorldTransformComponent& world)
-												   { world.update(); });
+	updateWorldTransforms();
 
 	mRegistry.view<SceneComponent>().each(
 		[this](auto entity, SceneComponent& scene)
@@ -576,18 +751,252 @@ bool Scene::onUpdate()
 	mStorage.clear();
 	mIsDirty = false;
 
+	destroy();
+
 	return isUpdate;
 }
 
+void Scene::markWorldTransformDirty(const Entity& entity)
+{
+	auto& world = entity.getComponent<WorldTransformComponent>();
+	if (world.isDirty)
+		return;
+
+	world.isDirty = true;
+	mWorldTransformDirty.push_back(entity);
+}
+
+void Scene::updateWorldTransforms()
+{
+	for (auto& entity : mWorldTransformDirty)
+	{
+		if (!mRegistry.valid(entity.mHandle))
+			continue;
+
+		auto& world = entity.getComponent<WorldTransformComponent>();
+		if (!world.isDirty)
+			continue;	 // already refreshed with a dirty ancestor
+
+		// start from the topmost dirty ancestor, so every entity is computed once and after its parent
+		Entity root = entity;
+		for (Entity parent = world.parent; !parent.isNull();)
+		{
+			auto& parentWorld = parent.getComponent<WorldTransformComponent>();
+			if (!parentWorld.isDirty)
+				break;
+			root = parent;
+			parent = parentWorld.parent;
+		}
+		UpdateWorldTransform(root);
+	}
+	mWorldTransformDirty.clear();
+}
+
 void Scene::destroy()
 {
-	// todo: refactor [create - reference - update - destroy] ... life cycle
-	mRegistry.view<DestroyState>().each([this](auto entity, DestroyState& destroy) { mRegistry.destroy(entity); });
+	if (mDestroyQueue.empty())
+		return;
+
+	// tvg::Scene::remove searches the paint list, so a large batch is detached by rebuilding from the draw order
+	if (mDestroyQueue.size() > Count_DestroyBatchRebuild)
+	{
+		mTvgScene->remove();
+		for (auto& entity : mDrawOrder)
+		{
+			if (auto* paint = GetPaint(this, entity))
+				mTvgScene->push(paint);
+		}
+	}
+	else
+	{
+		for (auto handle : mDestroyQueue)
+		{
+			if (auto* shape = mRegistry.try_get<ShapeComponent>(handle))
+				mTvgScene->remove(shape->shape);
+		}
+	}
+
+	for (auto handle : mDestroyQueue)
+	{
+		Entity entity(this, (uint32_t) handle);
+		if (auto* shape = entity.tryGetComponent<ShapeComponent>())
+		{
+			shape->shape->unref();
+		}
+		rEntityIndex->destroy(entity.getId());
+		for (auto& child : entity.getComponent<WorldTransformComponent>().children)
+		{
+			child.getScene()->markWorldTransformDirty(child);
+		}
+		ReparentWorldTransformChildren(entity);
+		DetachWorldTransform(entity);
+	}
+
+	mStorage.remove(mDestroyQueue.begin(), mDestroyQueue.end());
+	mRegistry.destroy(mDestroyQueue.begin(), mDestroyQueue.end());
+	mDestroyQueue.clear();
 }
 
 const std::list<Entity>& Scene::getDrawOrder()
 {
-	return mDrawOrder;
+	return mDrawOrder.list();
+}
+
+void Scene::flushSpatialIndex()
+{
+	mSpatialIndex.flush(
+		[this](entt::entity handle)
+		{
+			if (!mRegistry.valid(handle) || mRegistry.all_of<DestroyState>(handle))
+			{
+				mSpatialIndex.remove(handle);
+				return false;
+			}
+			// not applied to the shape until the next onUpdate
+			if (mRegistry.get<Dirty>(handle).mask != Dirty::Type::None)
+				return true;
+
+			auto [shape, bounds] = mRegistry.try_get<ShapeComponent, BoundsComponent>(handle);
+			if (shape == nullptr || !mDrawOrder.contains(Entity(this, (uint32_t) handle)))
+			{
+				mSpatialIndex.remove(handle);
+				return false;
+			}
+			if (bounds == nullptr)
+				bounds = &mRegistry.emplace<BoundsComponent>(handle);
+			Update(*bounds, *shape, mRegistry.get<WorldTransformComponent>(handle),
+				   mRegistry.try_get<StrokeComponent>(handle));
+			if (bounds->isEmpty)
+			{
+				mSpatialIndex.remove(handle);
+				return false;
+			}
+
+			// indexed in the space of this scene, so moving the scene, zoom and pan do not touch the grid
+			const auto& m = mRegistry.get<TransformComponent>(handle).localTransform;
+			const std::array<Vec2, 4> corners{bounds->localMin * m, Vec2{bounds->localMax.x, bounds->localMin.y} * m,
+											  bounds->localMax * m, Vec2{bounds->localMin.x, bounds->localMax.y} * m};
+			Vec2 minXy = corners[0];
+			Vec2 maxXy = corners[0];
+			for (const auto& p : corners)
+			{
+				minXy = Vec2{std::min(minXy.x, p.x), std::min(minXy.y, p.y)};
+				maxXy = Vec2{std::max(maxXy.x, p.x), std::max(maxXy.y, p.y)};
+			}
+			mSpatialIndex.set(handle, minXy, maxXy);
+			return false;
+		});
+}
+
+template <typename TComponent>
+static ComponentMemory MeasureComponents(entt::registry& registry)
+{
+	ComponentMemory memory;
+	registry.view<TComponent>().each(
+		[&memory](auto entity, const TComponent& component)
+		{
+			memory.count++;
+			memory.bytes += component.memoryUsage();
+		});
+	return memory;
+}
+
+template <typename TComponent>
+static void MeasureBake(entt::registry& registry, ComponentMemory& memory)
+{
+	registry.view<TComponent>().each(
+		[&memory](auto entity, const TComponent& component)
+		{
+			const size_t bytes = component.bakeMemoryUsage();
+			if (bytes == 0)
+				return;
+			memory.count++;
+			memory.bytes += bytes;
+		});
+}
+
+SceneMemoryReport Scene::memoryReport()
+{
+	SceneMemoryReport report;
+	report.transformKeyframe = MeasureComponents<TransformKeyframeComponent>(mRegistry);
+	report.pathList = MeasureComponents<PathListComponent>(mRegistry);
+	report.solidFill = MeasureComponents<SolidFillComponent>(mRegistry);
+	report.stroke = MeasureComponents<StrokeComponent>(mRegistry);
+	MeasureBake<TransformKeyframeComponent>(mRegistry, report.bake);
+	MeasureBake<PathListComponent>(mRegistry, report.bake);
+	MeasureBake<SolidFillComponent>(mRegistry, report.bake);
+	MeasureBake<StrokeComponent>(mRegistry, report.bake);
+	return report;
+}
+
+void Scene::pickCandidates(const Vec2& worldPoint, std::vector<Entity>& out)
+{
+	// the candidates are read between updates (hover, drag, marquee), transforms edited since then apply first
+	updateWorldTransforms();
+	flushSpatialIndex();
+
+	const auto& inverse = mSceneEntity.getComponent<WorldTransformComponent>().inverseWorldTransform();
+	mPickBuffer.clear();
+	mSpatialIndex.query(worldPoint * inverse, mPickBuffer);
+
+	// nested scenes are not indexed here, their shapes live in their own index
+	mRegistry.view<SceneComponent>().each(
+		[this](auto handle, SceneComponent& scene)
+		{
+			if (scene.scene != this && !mRegistry.all_of<DestroyState>(handle))
+				mPickBuffer.push_back(handle);
+		});
+
+	const size_t begin = out.size();
+	for (auto handle : mPickBuffer)
+	{
+		Entity entity(this, (uint32_t) handle);
+		if (mDrawOrder.contains(entity))
+			out.push_back(entity);
+	}
+	std::sort(out.begin() + begin, out.end(),
+			  [this](const Entity& lhs, const Entity& rhs) { return mDrawOrder.rank(lhs) > mDrawOrder.rank(rhs); });
+}
+
+void Scene::rectCandidates(const Vec2& worldMin, const Vec2& worldMax, std::vector<Entity>& out)
+{
+	updateWorldTransforms();
+	flushSpatialIndex();
+
+	// the rect in scene space is a quad, query its aabb and check the world bounds after
+	const auto& inverse = mSceneEntity.getComponent<WorldTransformComponent>().inverseWorldTransform();
+	const std::array<Vec2, 4> corners{worldMin * inverse, Vec2{worldMax.x, worldMin.y} * inverse,
+									  worldMax * inverse, Vec2{worldMin.x, worldMax.y} * inverse};
+	Vec2 minXy = corners[0];
+	Vec2 maxXy = corners[0];
+	for (const auto& p : corners)
+	{
+		minXy = Vec2{std::min(minXy.x, p.x), std::min(minXy.y, p.y)};
+		maxXy = Vec2{std::max(maxXy.x, p.x), std::max(maxXy.y, p.y)};
+	}
+	mPickBuffer.clear();
+	mSpatialIndex.query(minXy, maxXy, mPickBuffer);
+
+	for (auto handle : mPickBuffer)
+	{
+		auto [shape, bounds] = mRegistry.try_get<ShapeComponent, BoundsComponent>(handle);
+		if (shape == nullptr || bounds == nullptr)
+			continue;
+		Update(*bounds, *shape, mRegistry.get<WorldTransformComponent>(handle),
+			   mRegistry.try_get<StrokeComponent>(handle));
+		if (bounds->worldMin.x <= worldMax.x && worldMin.x <= bounds->worldMax.x &&
+			bounds->worldMin.y <= worldMax.y && worldMin.y <= bounds->worldMax.y)
+			out.emplace_back(this, (uint32_t) handle);
+	}
+
+	// nested scenes keep their shapes in their own index, the same way pickCandidates finds them
+	mRegistry.view<SceneComponent>().each(
+		[&](auto handle, SceneComponent& scene)
+		{
+			if (scene.scene != this && !mRegistry.all_of<DestroyState>(handle) &&
+				mDrawOrder.contains(Entity(this, (uint32_t) handle)))
+				scene.scene->rectCandidates(worldMin, worldMax, out);
+		});
 }
 
 }	 // namespace core
\ No newline at end of file
@@ -2,6 +2,9 @@
 #define _CORE_SCENE_SCENE_H_
 
 #include "entity.h"
+#include "drawOrder.h"
+#include "entityIndex.h"
+#include "spatialIndex.h"
 
 #include "common/common.h"
 
@@ -15,20 +18,44 @@ using reactive_storage = entt::reactive_mixin<entt::basic_storage<void>>;
 namespace core
 {
 
+class Animator;
 class CanvasWrapper;
 class Entity;
 
+// a primitive layer (Rect, Ellipse, Polygon or Star) fitted to [minXy, minXy + wh], see Scene::createLayers
+struct LayerDescriptor
+{
+	IPath::Type type{IPath::Type::Rect};
+	Vec2 minXy{0.0f, 0.0f};
+	Vec2 wh{1.0f, 1.0f};
+	bool hasStroke{false};
+};
+
+// inline size and allocated bytes of the components of one type, see Scene::memoryReport
+struct ComponentMemory
+{
+	size_t count{0};
+	size_t bytes{0};
+};
+
+struct SceneMemoryReport
+{
+	ComponentMemory transformKeyframe;
+	ComponentMemory pathList;
+	ComponentMemory solidFill;
+	ComponentMemory stroke;
+	ComponentMemory bake;	 // baked samples of the components above, count is the components holding any
+};
+
 class Scene
 {
 public:
 	static Entity CreateEntity(Scene* scene, std::string_view name, Entity parent);
+	// resolved through the paint id (the id of the scene entity), no hashing
 	static Scene* FindScene(tvg::Scene* scene);
+	// O(1), returns a null Entity for a stale or unknown id
 	static Entity FindEntity(uint32_t entityId);
 
-protected:
-	static std::unordered_map<tvg::Scene*, Scene*> gSceneMap;
-	static std::unordered_map<uint32_t, Entity> gEntityMap;
-
 public:
 	Scene(Scene* parentScene = nullptr);
 	~Scene();
@@ -46,9 +73,15 @@ public:
 	Entity createPolygonFillStrokeLayer(Vec2 minXy, Vec2 wh);
 	Entity createStarFillLayer(Vec2 minXy, Vec2 wh);
 
+	// creates count layers in one batch: storage is reserved up front, the shapes are built on the next
+	// onUpdate and pushed into the tvg scene together. faster than the create*Layer calls for large scenes
+	std::vector<Entity> createLayers(const LayerDescriptor* descriptors, size_t count);
+
 	// a deep-copied PathLayer using the first point of the pathList as the origin.
 	Entity createPathLayer(PathPoints pathList);
 	Entity createObb(const std::array<Vec2, 4>& points);
+	// moves the outline of an entity made by createObb, applied on the next onUpdate
+	void updateObb(Entity& entity, const std::array<Vec2, 4>& points);
 
 	template <typename T>
 	std::vector<Entity> findByComponent()
@@ -64,8 +97,11 @@ public:
 	Entity getEntityById(uint32_t id);
 	Entity tryGetEntityById(uint32_t id);
 
+	// queues the entity for destroy(), it leaves the draw order right away
 	void destroyEntity(Entity& entity);
 	void pushCanvas(CanvasWrapper* canvas);
+
+	// rebuild the whole tvg scene from the draw order
 	void reorder();
 
 	void changeDrawOrder(const Entity& entity, ChangeOrderType changeOrderType);
@@ -76,23 +112,75 @@ public:
 	}
 
 	bool onUpdate();
+	// processes the destroy queue in one batch (called at the end of onUpdate)
 	void destroy();
 
+	// queues the world transform of entity (and its subtree) for the next updateWorldTransforms
+	void markWorldTransformDirty(const Entity& entity);
+	// recomputes only the queued subtrees, each entity once, parents before children
+	void updateWorldTransforms();
+
 	const std::list<Entity>& getDrawOrder();
 
+	// shapes whose bounds contain worldPoint and the nested scenes of this scene, front to back in draw order.
+	// entities changed since the last call are re-indexed first
+	void pickCandidates(const Vec2& worldPoint, std::vector<Entity>& out);
+	// shapes of this scene and its nested scenes whose world bounds overlap the rect [worldMin, worldMax],
+	// in no particular order
+	void rectCandidates(const Vec2& worldMin, const Vec2& worldMax, std::vector<Entity>& out);
+
+	// memory held by the animated components of this scene (nested scenes report their own)
+	SceneMemoryReport memoryReport();
+
 	uint32_t mId;
 	Entity mSceneEntity;
 	Scene* rParentScene{nullptr};
 
 protected:
+	// a primitive layer with its path, fill and tvg shape, not yet updated nor pushed into mTvgScene
+	Entity createPrimitiveLayer(IPath::Type type, Vec2 minXy, Vec2 wh);
+
+	// bakes the tracks within the budget and evaluates them at the animator's current frame
+	void updateKeyframes(const Animator& animator);
+
+	// evaluates func(TComponents&...) over the view in parallel chunks, then marks changed entities dirty in view order
+	template <typename... TComponents, typename Func>
+	void evaluateKeyframes(Dirty::Type dirtyType, Func func);
+	// calls func(TComponent&) over the view in parallel chunks, func bakes the tracks it owns
+	template <typename TComponent, typename Func>
+	void bakeKeyframes(Func func);
+
 	friend class Entity;
 	friend class AnimationCreatorCanvas;
 	entt::registry mRegistry{};
+	std::unique_ptr<EntityIndex> mEntityIndex;	  // owned by the root scene of the document
+	EntityIndex* rEntityIndex{nullptr};
 	std::vector<CanvasWrapper*> rCanvasList;
-	std::list<Entity> mDrawOrder;
+	DrawOrder mDrawOrder;
 	tvg::Scene* mTvgScene;
 	reactive_storage mStorage;
 	bool mIsDirty{false};
+
+	// keyframe evaluation buffers, reused across frames
+	std::vector<entt::entity> mEvalEntities;
+	std::vector<uint8_t> mEvalChanged;
+	float mEvaluatedFrameNo{-1.0f};	   // frame of the last keyframe evaluation
+	uint32_t mEvaluatedRevision{0};	   // gKeyframeRevision of the last keyframe evaluation
+
+	// every track is baked over [mBakedFrom, mBakedTo] as of keyframe revision mBakedRevision (0 if not yet)
+	uint32_t mBakedRevision{0};
+	uint32_t mBakedFrom{0};
+	uint32_t mBakedTo{0};
+	bool mIsBakedQuantized{false};
+
+	std::vector<Entity> mWorldTransformDirty;
+	std::vector<entt::entity> mDestroyQueue;
+
+	// re-indexes the entities changed since the last query
+	void flushSpatialIndex();
+
+	SpatialIndex mSpatialIndex;	   // scene-space bounds of the shapes, see pickCandidates
+	std::vector<entt::entity> mPickBuffer;
 };
 
 }	 // namespace core
@@ -0,0 +1,204 @@
+#include "spatialIndex.h"
+
+#include <algorithm>
+
+namespace core
+{
+
+static void EraseFrom(std::vector<entt::entity>& list, entt::entity entity)
+{
+	auto it = std::find(list.begin(), list.end(), entity);
+	if (it != list.end())
+	{
+		*it = list.back();
+		list.pop_back();
+	}
+}
+
+SpatialIndex::Item& SpatialIndex::item(entt::entity entity)
+{
+	const auto idx = static_cast<size_t>(entt::to_entity(entity));
+	if (idx >= mItems.size())
+	{
+		mItems.resize(idx + 1);
+	}
+	auto& item = mItems[idx];
+	if (item.entity != entity)
+	{
+		// the slot was reused by a new entity, drop what the old one left behind
+		unlink(item);
+		item = Item{.entity = entity};
+	}
+	return item;
+}
+
+void SpatialIndex::markDirty(entt::entity entity)
+{
+	auto& target = item(entity);
+	if (target.isPending)
+		return;
+	target.isPending = true;
+	mPending.push_back(entity);
+}
+
+void SpatialIndex::set(entt::entity entity, const Vec2& minXy, const Vec2& maxXy)
+{
+	auto& target = item(entity);
+	const int x0 = ToCell(minXy.x);
+	const int y0 = ToCell(minXy.y);
+	const int x1 = ToCell(maxXy.x);
+	const int y1 = ToCell(maxXy.y);
+	const bool isLarge = static_cast<int64_t>(x1 - x0 + 1) * (y1 - y0 + 1) > Count_MaxCell;
+
+	target.minXy = minXy;
+	target.maxXy = maxXy;
+	if (target.isInserted && target.isLarge == isLarge &&
+		(isLarge || (target.x0 == x0 && target.y0 == y0 && target.x1 == x1 && target.y1 == y1)))
+	{
+		// same cells, only the box changed
+		return;
+	}
+
+	unlink(target);
+	target.isInserted = true;
+	target.isLarge = isLarge;
+	target.x0 = x0;
+	target.y0 = y0;
+	target.x1 = x1;
+	target.y1 = y1;
+	mCount++;
+
+	if (isLarge)
+	{
+		mLarge.push_back(entity);
+		return;
+	}
+	for (int y = y0; y <= y1; y++)
+	{
+		for (int x = x0; x <= x1; x++)
+		{
+			mCells[ToKey(x, y)].push_back(entity);
+		}
+	}
+}
+
+void SpatialIndex::remove(entt::entity entity)
+{
+	const auto idx = static_cast<size_t>(entt::to_entity(entity));
+	if (idx < mItems.size() && mItems[idx].entity == entity)
+	{
+		unlink(mItems[idx]);
+	}
+}
+
+void SpatialIndex::unlink(Item& item)
+{
+	if (!item.isInserted)
+		return;
+
+	item.isInserted = false;
+	mCount--;
+	if (item.isLarge)
+	{
+		EraseFrom(mLarge, item.entity);
+		return;
+	}
+	for (int y = item.y0; y <= item.y1; y++)
+	{
+		for (int x = item.x0; x <= item.x1; x++)
+		{
+			auto it = mCells.find(ToKey(x, y));
+			if (it == mCells.end())
+				continue;
+			EraseFrom(it->second, item.entity);
+			if (it->second.empty())
+				mCells.erase(it);
+		}
+	}
+}
+
+void SpatialIndex::query(const Vec2& point, std::vector<entt::entity>& out) const
+{
+	auto test = [this, &point, &out](entt::entity entity)
+	{
+		const auto& item = mItems[static_cast<size_t>(entt::to_entity(entity))];
+		if (item.minXy.x <= point.x && point.x <= item.maxXy.x && item.minXy.y <= point.y && point.y <= item.maxXy.y)
+			out.push_back(entity);
+	};
+
+	if (auto it = mCells.find(ToKey(ToCell(point.x), ToCell(point.y))); it != mCells.end())
+	{
+		for (auto entity : it->second)
+		{
+			test(entity);
+		}
+	}
+	for (auto entity : mLarge)
+	{
+		test(entity);
+	}
+}
+
+void SpatialIndex::query(const Vec2& minXy, const Vec2& maxXy, std::vector<entt::entity>& out) const
+{
+	if (++mQueryStamp == 0)
+	{
+		for (auto& item : mItems)
+		{
+			item.queryStamp = 0;
+		}
+		mQueryStamp = 1;
+	}
+
+	auto test = [this, &minXy, &maxXy, &out](entt::entity entity)
+	{
+		const auto& item = mItems[static_cast<size_t>(entt::to_entity(entity))];
+		if (item.queryStamp == mQueryStamp)
+			return;
+		item.queryStamp = mQueryStamp;
+		if (item.minXy.x <= maxXy.x && minXy.x <= item.maxXy.x && item.minXy.y <= maxXy.y && minXy.y <= item.maxXy.y)
+			out.push_back(entity);
+	};
+
+	const int x0 = ToCell(minXy.x);
+	const int y0 = ToCell(minXy.y);
+	const int x1 = ToCell(maxXy.x);
+	const int y1 = ToCell(maxXy.y);
+	if (static_cast<int64_t>(x1 - x0 + 1) * (y1 - y0 + 1) > static_cast<int64_t>(mCells.size()))
+	{
+		// a rect larger than the occupied area, walk the occupied cells instead
+		for (const auto& [key, entities] : mCells)
+		{
+			const int x = static_cast<int32_t>(key >> 32);
+			const int y = static_cast<int32_t>(key & 0xFFFFFFFFu);
+			if (x < x0 || x1 < x || y < y0 || y1 < y)
+				continue;
+			for (auto entity : entities)
+			{
+				test(entity);
+			}
+		}
+	}
+	else
+	{
+		for (int y = y0; y <= y1; y++)
+		{
+			for (int x = x0; x <= x1; x++)
+			{
+				auto it = mCells.find(ToKey(x, y));
+				if (it == mCells.end())
+					continue;
+				for (auto entity : it->second)
+				{
+					test(entity);
+				}
+			}
+		}
+	}
+	for (auto entity : mLarge)
+	{
+		test(entity);
+	}
+}
+
+}	 // namespace core
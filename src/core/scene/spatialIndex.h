@@ -0,0 +1,91 @@
+#ifndef _CORE_SCENE_SPATIAL_INDEX_H_
+#define _CORE_SCENE_SPATIAL_INDEX_H_
+
+#include "entity.h"
+
+#include <cmath>
+#include <unordered_map>
+#include <vector>
+
+namespace core
+{
+
+// uniform grid over the scene-space aabb of the shape entities of one scene, used for point queries (pick, hover).
+// changed entities are only queued (markDirty); the owner re-inserts them in flush() before the next query,
+// so a burst of edits or a playing animation costs one update per entity and query
+class SpatialIndex
+{
+public:
+	static constexpr float Size_Cell = 128.0f;
+	static constexpr int Count_MaxCell = 64;	// boxes covering more cells go to a list tested on every query
+
+	void markDirty(entt::entity entity);
+
+	// calls update(entity) for every queued entity, update returns true to keep it queued
+	template <typename Func>
+	void flush(Func update)
+	{
+		mFlushing.swap(mPending);
+		for (auto entity : mFlushing)
+		{
+			item(entity).isPending = false;
+		}
+		for (auto entity : mFlushing)
+		{
+			if (update(entity))
+				markDirty(entity);
+		}
+		mFlushing.clear();
+	}
+
+	void set(entt::entity entity, const Vec2& minXy, const Vec2& maxXy);
+	void remove(entt::entity entity);
+
+	// entities whose box contains point (scene space), in no particular order
+	void query(const Vec2& point, std::vector<entt::entity>& out) const;
+	// entities whose box overlaps [minXy, maxXy] (scene space), each once, in no particular order
+	void query(const Vec2& minXy, const Vec2& maxXy, std::vector<entt::entity>& out) const;
+
+	size_t size() const
+	{
+		return mCount;
+	}
+
+private:
+	struct Item
+	{
+		entt::entity entity{entt::null};
+		Vec2 minXy;
+		Vec2 maxXy;
+		int x0{0}, y0{0}, x1{-1}, y1{-1};	 // covered cells, empty if x1 < x0
+		bool isInserted{false};
+		bool isLarge{false};
+		bool isPending{false};
+		mutable uint32_t queryStamp{0};	   // last rect query that visited the item, an item spans many cells
+	};
+
+	static int ToCell(float v)
+	{
+		return static_cast<int>(std::floor(v / Size_Cell));
+	}
+	static uint64_t ToKey(int x, int y)
+	{
+		return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+	}
+
+	Item& item(entt::entity entity);
+	void unlink(Item& item);
+
+private:
+	std::vector<Item> mItems;	 // registry slot -> item
+	std::unordered_map<uint64_t, std::vector<entt::entity>> mCells;
+	std::vector<entt::entity> mLarge;
+	std::vector<entt::entity> mPending;
+	std::vector<entt::entity> mFlushing;
+	size_t mCount{0};
+	mutable uint32_t mQueryStamp{0};
+};
+
+}	 // namespace core
+
+#endif
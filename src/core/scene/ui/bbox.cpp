@@ -84,10 +84,11 @@ bool BBox::onStartClickLeftMouse(const InputValue& inputValue)
 		if (mControlBox[type]->onStartLeftDown(mStartPoint))
 		{
 			mBeforeTransform = rTarget.getComponent<TransformComponent>();
-			auto& world = rTarget.getComponent<WorldTransformComponent>();
-			mBeforeInvWorldTransform = world.inverseWorldTransform;
-			if (world.parentTransform)
-				mBeforeParentInvWorldTransform = world.parentTransform->inverseWorldTransform;
+			auto& world = GetWorldTransform(rTarget);
+			mBeforeInvWorldTransform = world.inverseWorldTransform();
+			if (!world.parent.isNull())
+				mBeforeParentInvWorldTransform =
+					world.parent.getComponent<WorldTransformComponent>().inverseWorldTransform();
 			else
 				mBeforeParentInvWorldTransform = identity();
 			mCurrentControlType = ControlType(type);
@@ -156,7 +157,6 @@ void BBox::init()
 	if (rTarget.isNull() || !rTarget.hasComponent<ShapeComponent>())
 		return;
 
-	auto& targetShape = rTarget.getComponent<ShapeComponent>();
 	auto moveAnchorPoint = [this]()
 	{
 		LOG_INFO("TODO: move AnchorPoint");
@@ -208,7 +208,7 @@ void BBox::init()
 
 	auto rotationLambda = [this]()
 	{
-		auto inv = rTarget.getComponent<WorldTransformComponent>().inverseWorldTransform;	 // (R^T, -R^T T)
+		auto inv = GetWorldTransform(rTarget).inverseWorldTransform();	  // (R^T, -R^T T)
 		auto scale = rTarget.getComponent<TransformComponent>().scale;
 		auto dir = 0 < scale.x * scale.y ? 1.0f : -1.0f;
 		auto before = mBeforePoint * inv;
@@ -234,9 +234,10 @@ void BBox::init()
 	// todo: scale mode, dimension mode
 	// todo: reset -> hide & show & move
 	// todo: reset unique_ptr -> move point, change transform box (apply target transform)
-	std::array<Vec2, 4> points = GetObb(targetShape.shape);
+	std::array<Vec2, 4> points;
+	GetObb(rTarget, points);
 	auto& targetTransform = rTarget.getComponent<TransformComponent>();
-	auto& targetWorldTransform = rTarget.getComponent<WorldTransformComponent>();
+	auto& targetWorldTransform = GetWorldTransform(rTarget);
 	const auto centerPoint = targetWorldTransform.worldPosition;
 	auto wh = Vec2{CommonSetting::Width_DefaultBBoxControlBox, CommonSetting::Width_DefaultBBoxControlBox};
 
@@ -108,15 +108,13 @@ void UIShape::moveTo(const Vec2& xy)
 {
 	mEntity.move(xy);
 
-	auto& shape = mEntity.getComponent<ShapeComponent>();
-	mObbPoints = GetObb(shape.shape);
+	GetObb(mEntity, mObbPoints);
 }
 void UIShape::moveByDelta(const Vec2& delta)
 {
 	mEntity.moveByDelta(delta);
 
-	auto& shape = mEntity.getComponent<ShapeComponent>();
-	mObbPoints = GetObb(shape.shape);
+	GetObb(mEntity, mObbPoints);
 }
 bool UIShape::onStartLeftDown(Vec2 xy)
 {
@@ -219,6 +217,7 @@ void UIShape::updatePath(PathPoints pathPoints)
 			pathPoints.begin()->type = PathPoint::Command::MoveTo;
 		}
 		path->path = pathPoints;
+		path->markChanged();
 		init();
 		mEntity.setDirty(Dirty::Type::Path);
 		// Update(mEntity.getComponent<ShapeComponent>(), *path);
@@ -227,7 +226,7 @@ void UIShape::updatePath(PathPoints pathPoints)
 
 Vec2 UIShape::getWorldPosition()
 {
-	return mEntity.getComponent<WorldTransformComponent>().worldPosition;
+	return GetWorldTransform(mEntity).worldPosition;
 }
 
 void UIShape::setVisible(bool visible)
@@ -308,8 +307,7 @@ void UIShape::init()
 		case ShapeType::Ellipse:
 		case ShapeType::Polygon:
 		{
-			auto& shape = mEntity.getComponent<ShapeComponent>();
-			mObbPoints = GetObb(shape.shape);
+			GetObb(mEntity, mObbPoints);
 			break;
 		}
 	}
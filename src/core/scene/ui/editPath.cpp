@@ -78,7 +78,7 @@ void EditPath::onUpdate()
 	if (mIsDirty)
 	{
 		mIsDirty = false;
-		auto world = rTarget.getComponent<WorldTransformComponent>();
+		auto& world = rTarget.getComponent<WorldTransformComponent>();
 		for (int i = 0; i < rPathPoints->size(); i++)
 		{
 			auto& point = rPathPoints->at(i);
@@ -136,8 +136,8 @@ bool EditPath::onDragLeftMouse(const InputValue& inputValue)
 			{
 				mCurrentEditType = PathPoint::Command::CubicTo;
 				auto& transform = rTarget.getComponent<WorldTransformComponent>();
-				auto localStart = mStartPoint * transform.inverseWorldTransform;
-				auto localCurrent = mCurrentPoint * transform.inverseWorldTransform;
+				auto localStart = mStartPoint * transform.inverseWorldTransform();
+				auto localCurrent = mCurrentPoint * transform.inverseWorldTransform();
 				auto localDelta = localCurrent - localStart;
 
 				auto point = ToEdit_PathPoint(rPathPoints->at(mCurrentPointIndex));
@@ -265,8 +265,8 @@ void EditPath::initControlPoint()
 			[this]()
 			{
 				auto& transform = rTarget.getComponent<WorldTransformComponent>();
-				auto localCurrent = mCurrentPoint * transform.inverseWorldTransform;
-				auto localBefore = mBeforePoint * transform.inverseWorldTransform;
+				auto localCurrent = mCurrentPoint * transform.inverseWorldTransform();
+				auto localBefore = mBeforePoint * transform.inverseWorldTransform();
 				auto localDelta = (localCurrent - localBefore);
 				auto delta = (mCurrentPoint - mBeforePoint);
 				auto point = ToEdit_PathPoint(rPathPoints->at(mCurrentPointIndex));
@@ -296,8 +296,8 @@ void EditPath::initControlPoint()
 			[this]()
 			{
 				auto& transform = rTarget.getComponent<WorldTransformComponent>();
-				auto localCurrent = mCurrentPoint * transform.inverseWorldTransform;
-				auto localBefore = mBeforePoint * transform.inverseWorldTransform;
+				auto localCurrent = mCurrentPoint * transform.inverseWorldTransform();
+				auto localBefore = mBeforePoint * transform.inverseWorldTransform();
 				auto localDelta = (localCurrent - localBefore);
 				auto delta = (mCurrentPoint - mBeforePoint);
 				auto point = ToEdit_PathPoint(rPathPoints->at(mCurrentPointIndex));
@@ -339,8 +339,8 @@ void EditPath::addPathPointControl(const Vec2& worldPosition)
 		[this, idx = mPathPointUIs.size() - 1]()
 		{
 			auto& transform = rTarget.getComponent<WorldTransformComponent>();
-			auto localCurrent = mCurrentPoint * transform.inverseWorldTransform;
-			auto localBefore = mBeforePoint * transform.inverseWorldTransform;
+			auto localCurrent = mCurrentPoint * transform.inverseWorldTransform();
+			auto localBefore = mBeforePoint * transform.inverseWorldTransform();
 
 			auto localDelta = localCurrent - localBefore;
 			auto delta = (mCurrentPoint - mBeforePoint);
@@ -361,7 +361,7 @@ void EditPath::addPathPointControl(const Vec2& worldPosition)
 void EditPath::addPathPoint(const Vec2& worldPoisition)
 {
 	auto& transform = rTarget.getComponent<WorldTransformComponent>();
-	auto localPosition = worldPoisition * transform.inverseWorldTransform;
+	auto localPosition = worldPoisition * transform.inverseWorldTransform();
 	Edit_PathPoint pathPoint{
 		.localPosition = {localPosition.x, localPosition.y},
 		.type = static_cast<Edit_PathPointType>(rPathPoints->empty() ? PathPoint::Command::MoveTo : mCurrentEditType)};
@@ -12,10 +12,49 @@
 namespace core
 {
 
+// world box around the obbs of the entities, false if none has geometry
+static bool GetSelectionObb(const std::vector<Entity>& entities, std::array<Vec2, 4>& out)
+{
+	Vec2 minXy{std::numeric_limits<float>::max(), std::numeric_limits<float>::max()};
+	Vec2 maxXy{std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest()};
+	bool isEmpty = true;
+	for (const auto& entity : entities)
+	{
+		std::array<Vec2, 4> obb;
+		if (entity.isNull() || !GetObb(entity, obb))
+			continue;
+		isEmpty = false;
+		for (const auto& p : obb)
+		{
+			minXy = Vec2{std::min(minXy.x, p.x), std::min(minXy.y, p.y)};
+			maxXy = Vec2{std::max(maxXy.x, p.x), std::max(maxXy.y, p.y)};
+		}
+	}
+	out = {minXy, Vec2{maxXy.x, minXy.y}, maxXy, Vec2{minXy.x, maxXy.y}};
+	return !isEmpty;
+}
+
 void SelectionManager::Select(AnimationCreatorCanvas* canvas, Entity entity)
 {
 	Clear(canvas);
-	Get().mSelectList[canvas].push_back(entity);
+	Push(canvas, entity);
+	if (canvas->mInputController->getMode() != EditModeType::PICK)
+	{
+		canvas->mInputController->setMode(EditModeType::PICK);
+	}
+}
+void SelectionManager::Select(AnimationCreatorCanvas* canvas, const std::vector<Entity>& entities)
+{
+	Clear(canvas);
+	auto& selectList = Get().mSelectList[canvas];
+	auto& selectIds = Get().mSelectIds[canvas];
+	selectList.reserve(entities.size());
+	selectIds.reserve(entities.size());
+	for (auto& entity : entities)
+	{
+		if (selectIds.insert(entity.getId()).second)
+			selectList.push_back(entity);
+	}
 	if (canvas->mInputController->getMode() != EditModeType::PICK)
 	{
 		canvas->mInputController->setMode(EditModeType::PICK);
@@ -27,9 +66,10 @@ void SelectionManager::Hover(AnimationCreatorCanvas* canvas, Entity entity)
 }
 void SelectionManager::Push(AnimationCreatorCanvas* canvas, Entity entity)
 {
-	// todo: multiSelection
-	Select(canvas, entity);
-	// Get().mSelectList.push_back(entity);
+	if (entity.isNull())
+		return;
+	if (Get().mSelectIds[canvas].insert(entity.getId()).second)
+		Get().mSelectList[canvas].push_back(entity);
 }
 
 void SelectionManager::Update(AnimationCreatorCanvas* canvas)
@@ -41,12 +81,7 @@ void SelectionManager::Update(AnimationCreatorCanvas* canvas)
 
 bool SelectionManager::IsSelected(AnimationCreatorCanvas* canvas, int id)
 {
-	for (auto& entity : Get().mSelectList[canvas])
-	{
-		if (entity.getId() == id)
-			return true;
-	}
-	return false;
+	return Get().mSelectIds[canvas].count(static_cast<EntityID>(id)) > 0;
 }
 
 bool SelectionManager::SetEditPath(AnimationCreatorCanvas* canvas, Entity entity, int pathIdx)
@@ -70,6 +105,11 @@ Entity SelectionManager::GetFirstSelectedEntity(AnimationCreatorCanvas* canvas)
 	return selectList.at(0);
 }
 
+const std::vector<Entity>& SelectionManager::GetSelectedEntities(AnimationCreatorCanvas* canvas)
+{
+	return Get().mSelectList[canvas];
+}
+
 void SelectionManager::Update()
 {
 }
@@ -77,6 +117,7 @@ void SelectionManager::Update()
 void SelectionManager::Clear(AnimationCreatorCanvas* canvas)
 {
 	Get().mSelectList[canvas].clear();
+	Get().mSelectIds[canvas].clear();
 	Get().mEditPath[canvas] = -1;
 }
 
@@ -107,6 +148,27 @@ void SelectionManager::updateSelect(AnimationCreatorCanvas* canvas, bool disable
 		auto& bboxComp = bbox.addComponent<BBoxControlComponent>();
 		bboxComp.bbox = std::make_unique<BBox>(canvas->getInputController(), canvas->mControlScene.get(), target);
 	}
+
+	// the bbox controls edit the first entity only, one outline shows what else the marquee selected
+	auto& selectionObb = mSelectionObb[canvas];
+	std::array<Vec2, 4> points;
+	if (disable || entityList.size() < 2 || !GetSelectionObb(entityList, points))
+	{
+		if (!selectionObb.entity.isNull())
+			canvas->mControlScene->destroyEntity(selectionObb.entity);
+		return;
+	}
+	if (selectionObb.entity.isNull())
+	{
+		selectionObb.entity = canvas->mControlScene->createObb(points);
+		selectionObb.entity.getComponent<StrokeComponent>().color = CommonSetting::Color_DefaultMarqueeOutline;
+	}
+	else if (points[0].x != selectionObb.points[0].x || points[0].y != selectionObb.points[0].y ||
+			 points[2].x != selectionObb.points[2].x || points[2].y != selectionObb.points[2].y)
+	{
+		canvas->mControlScene->updateObb(selectionObb.entity, points);
+	}
+	selectionObb.points = points;
 }
 
 void SelectionManager::updateHover(AnimationCreatorCanvas* canvas)
@@ -120,7 +182,8 @@ void SelectionManager::updateHover(AnimationCreatorCanvas* canvas)
 	auto target = mHover[canvas];
 	if (!target.isNull() && target.hasComponent<ShapeComponent>())
 	{
-		std::array<Vec2, 4> points = GetObb(target.getComponent<ShapeComponent>().shape);
+		std::array<Vec2, 4> points;
+		GetObb(target, points);
 		hover[canvas] = canvas->mControlScene->createObb(points);
 		hover[canvas].getComponent<StrokeComponent>().color = CommonSetting::Color_DefaultHoverOutline;
 	}
@@ -2,7 +2,10 @@
 #define _CORE_SELECTION_MANAGER_H_
 
 #include "scene/entity.h"
+#include <array>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 namespace core
 {
@@ -14,10 +17,19 @@ class SelectionManager
 		Entity entity;
 		int pathIndex;
 	};
+	// outline around a multi-selection, kept until the selection or its bounds change
+	struct SelectionObb
+	{
+		Entity entity;
+		std::array<Vec2, 4> points;
+	};
 
 public:
 	static void Select(AnimationCreatorCanvas* canvas, Entity entity);
+	// replaces the selection (marquee), the first entity gets the bbox and the whole selection one outline
+	static void Select(AnimationCreatorCanvas* canvas, const std::vector<Entity>& entities);
 	static void Hover(AnimationCreatorCanvas* canvas, Entity entity);
+	// adds entity to the selection, ignored if it is already selected
 	static void Push(AnimationCreatorCanvas* canvas, Entity entity);
 	static void Clear(AnimationCreatorCanvas* canvas);
 	static void Update();
@@ -25,6 +37,7 @@ public:
 	static bool IsSelected(AnimationCreatorCanvas* canvas, int id);
 	static bool SetEditPath(AnimationCreatorCanvas* canvas, Entity entity, int pathIdx);
 	static Entity GetFirstSelectedEntity(AnimationCreatorCanvas* canvas);
+	static const std::vector<Entity>& GetSelectedEntities(AnimationCreatorCanvas* canvas);
 
 private:
 	static SelectionManager& Get();
@@ -36,7 +49,9 @@ private:
 
 private:
 	std::unordered_map<AnimationCreatorCanvas*, std::vector<Entity> > mSelectList;
+	std::unordered_map<AnimationCreatorCanvas*, std::unordered_set<EntityID> > mSelectIds;	  // ids of mSelectList
 	std::unordered_map<AnimationCreatorCanvas*, Entity> mHover;
+	std::unordered_map<AnimationCreatorCanvas*, SelectionObb> mSelectionObb;
 	std::unordered_map<AnimationCreatorCanvas*, int> mEditPath;
 };
 
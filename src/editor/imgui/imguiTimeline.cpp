@@ -5,9 +5,13 @@
 
 #include <core/core.h>
 
+#include <algorithm>
+
 namespace editor
 {
 
+static constexpr float Width_PreviewFpsInput = 100.0f;
+
 void ImguiTimeline::draw()
 {
 	mWindowFlags = 0;
@@ -47,6 +51,29 @@ void ImguiTimeline::drawSequencer()
 	{
 		animator->stop();
 	}
+	ImGui::SameLine();
+	int previewFps = static_cast<int>(animator->mPreviewFps);
+	ImGui::SetNextItemWidth(Width_PreviewFpsInput);
+	if (ImGui::InputInt("Preview fps", &previewFps))
+	{
+		animator->setPreviewFps(static_cast<uint32_t>(std::max(previewFps, 0)));
+	}
+	if (ImGui::IsItemHovered())
+	{
+		ImGui::SetTooltip("evaluation steps per second while playing, 0 follows the composition fps");
+	}
+	ImGui::SameLine();
+	bool isQuantizeBake = animator->mIsQuantizeBake;
+	if (ImGui::Checkbox("16-bit bake", &isQuantizeBake))
+	{
+		SetBakeQuantize(canvas, isQuantizeBake);
+	}
+	if (ImGui::IsItemHovered())
+	{
+		ImGui::SetTooltip("store the baked keyframe samples as 16 bits per channel");
+	}
+	ImGui::SameLine();
+	ImGui::Text("Dropped: %u", animator->mDroppedFrameCount);
 	ImGui::BeginChild("##Timeline", ImVec2(0, 0), false, mWindowFlags);
 	{
 		auto win_pos = ImGui::GetWindowPos();
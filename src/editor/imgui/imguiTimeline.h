@@ -55,21 +55,37 @@ public:
 									 auto* right = kf.right(currentFrame);
 									 if (left && right)
 									 {
-										 auto& out = left->outTangent;
-										 auto& in = right->inTangent;
+										 const auto out = kf.outTangent(*left);
+										 const auto in = kf.inTangent(*right);
 										 float data[5]{out.x, out.y, in.x, in.y};
 										 ImGui::Bezier("Edit Curve", data);
-										 out.x = data[0];
-										 out.y = data[1];
-										 in.x = data[2];
-										 in.y = data[3];
+										 if (out.x != data[0] || out.y != data[1] || in.x != data[2] || in.y != data[3])
+										 {
+											 kf.setTangents(*left, kf.inTangent(*left), {data[0], data[1]});
+											 kf.setTangents(*right, {data[2], data[3]}, kf.outTangent(*right));
+											 kf.markEdited();
+										 }
 									 }
 								 });
 
-			for (auto& kf : kf)
+			bool isMoved = false;
+			size_t movedIndex = T::Index_None;
+			size_t index = 0;
+			for (auto& key : kf)
 			{
-				ImGui::Keyframe(&kf.frame, mDragRect, nullptr, nullptr);
+				const auto frame = key.frame;
+				ImGui::Keyframe(&key.frame, mDragRect, nullptr, nullptr);
+				if (frame != key.frame)
+				{
+					isMoved = true;
+					movedIndex = index;
+				}
+				index++;
 			}
+			// a dragged key may pass or land on its neighbours, markEdited sorts the keys back and keeps the
+			// dragged one on a shared frame. the baked samples and constant ranges no longer match the keys
+			if (isMoved)
+				kf.markEdited(movedIndex);
 			ImGui::EndNeoTimeLine();
 		}
 	}
@@ -0,0 +1,38 @@
+#ifndef _TEST_COMMON_BENCHMARK_H_
+#define _TEST_COMMON_BENCHMARK_H_
+
+#include "scene/scene.h"
+
+#include <chrono>
+#include <ratio>
+#include <vector>
+
+// helpers shared by the benchmarks under test/
+
+// wall time of one call of func in TUnit: std::milli, std::micro or std::nano
+template <typename TUnit, typename Func>
+static double Measure(Func func)
+{
+	const auto begin = std::chrono::steady_clock::now();
+	func();
+	return std::chrono::duration<double, TUnit>(std::chrono::steady_clock::now() - begin).count();
+}
+
+// layers are laid out 256 per row with a 10 unit pitch, each an 8 x 8 rect
+static core::Vec2 GridPosition(int i)
+{
+	return {float(i % 256) * 10.0f, float(i / 256) * 10.0f};
+}
+
+static std::vector<core::LayerDescriptor> GridDescriptors(int count)
+{
+	std::vector<core::LayerDescriptor> descriptors(count);
+	for (int i = 0; i < count; i++)
+	{
+		descriptors[i].minXy = GridPosition(i);
+		descriptors[i].wh = {8.0f, 8.0f};
+	}
+	return descriptors;
+}
+
+#endif
@@ -0,0 +1,42 @@
+#include "scene/scene.h"
+#include "scene/component/components.h"
+
+#include "../common/benchmark.h"
+
+#include <thorvg.h>
+
+#include <cstdio>
+#include <vector>
+
+// cost of deleting every layer of a scene: destroyEntity only queues, the next onUpdate detaches and frees
+// the whole queue in one batch. the time per layer should stay flat as the layer count grows (linear total)
+
+int main()
+{
+	tvg::Initializer::init(0);
+	{
+		std::printf("%8s %14s %14s %16s\n", "layers", "queue (ms)", "flush (ms)", "per layer (us)");
+		for (int layerCount : {1000, 10000, 100000})
+		{
+			core::Scene scene;
+			const auto descriptors = GridDescriptors(layerCount);
+			auto layers = scene.createLayers(descriptors.data(), descriptors.size());
+			scene.onUpdate();
+
+			const double queueMs = Measure<std::milli>(
+				[&]
+				{
+					for (auto& layer : layers)
+					{
+						scene.destroyEntity(layer);
+					}
+				});
+			const double flushMs = Measure<std::milli>([&] { scene.onUpdate(); });
+
+			std::printf("%8d %14.2f %14.2f %16.3f\n", layerCount, queueMs, flushMs,
+						(queueMs + flushMs) * 1000.0 / layerCount);
+		}
+	}
+	tvg::Initializer::term();
+	return 0;
+}
@@ -0,0 +1,87 @@
+#include "scene/scene.h"
+#include "scene/component/components.h"
+
+#include "../common/benchmark.h"
+
+#include <thorvg.h>
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// cost of one reorder click against the layer count: Scene::changeDrawOrder (moves one paint)
+// next to Scene::reorder (removes and re-pushes every paint, what every click used to run).
+// a move is not O(1): tvg::Scene::remove and push(paint, at) walk the paint list to find the paints.
+// after the moves the paints of the tvg scene must still follow the draw order
+
+static constexpr int Count_Move = 200;
+
+// the tvg paints back to front match the shapes of the draw order (which also holds the scene's own entity)
+static bool IsPaintOrderSynced(core::Scene& scene)
+{
+	const auto& paints = scene.getScene()->paints();
+	auto paint = paints.begin();
+	for (const auto& entity : scene.getDrawOrder())
+	{
+		auto* shape = entity.tryGetComponent<core::ShapeComponent>();
+		if (shape == nullptr)
+			continue;
+		if (paint == paints.end() || *paint++ != shape->shape)
+			return false;
+	}
+	return paint == paints.end();
+}
+
+int main()
+{
+	int failCount = 0;
+	tvg::Initializer::init(0);
+	{
+		std::printf("%8s %16s %16s\n", "layers", "move (us/op)", "reorder (us/op)");
+		for (int layerCount : {1000, 4000, 16000, 64000})
+		{
+			core::Scene scene;
+			std::vector<core::Entity> layers;
+			layers.reserve(layerCount);
+			for (int i = 0; i < layerCount; i++)
+			{
+				layers.push_back(scene.createRectFillLayer({float(i % 256), float(i / 256)}, {8.0f, 8.0f}));
+			}
+
+			std::mt19937 rng(layerCount);
+			std::uniform_int_distribution<int> pick(0, layerCount - 1);
+			const core::ChangeOrderType types[] = {core::ChangeOrderType::ToFront, core::ChangeOrderType::ToBack,
+												   core::ChangeOrderType::ToForward,
+												   core::ChangeOrderType::ToBackward};
+
+			const double moveUs = Measure<std::micro>(
+				[&]
+				{
+					for (int i = 0; i < Count_Move; i++)
+					{
+						scene.changeDrawOrder(layers[pick(rng)], types[i % 4]);
+					}
+				});
+
+			if (!IsPaintOrderSynced(scene))
+			{
+				std::printf("failed: paints out of draw order after %d moves (%d layers)\n", Count_Move, layerCount);
+				failCount++;
+			}
+
+			const int reorderCount = layerCount > 16000 ? 2 : 10;
+			const double reorderUs = Measure<std::micro>(
+				[&]
+				{
+					for (int i = 0; i < reorderCount; i++)
+					{
+						scene.reorder();
+					}
+				});
+
+			std::printf("%8d %16.3f %16.1f\n", layerCount, moveUs / Count_Move, reorderUs / reorderCount);
+		}
+	}
+	tvg::Initializer::term();
+	return failCount == 0 ? 0 : 1;
+}
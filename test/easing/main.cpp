@@ -0,0 +1,116 @@
+#include "scene/entity.h"
+#include "scene/component/keyframe.h"
+
+#include <cmath>
+#include <cstdio>
+
+// accuracy of CubicBezierEasing against an exact solution (bisection in double), next to the 256-step
+// float bisection it replaced. fails if the solver is off by more than Threshold_MaxError anywhere on the grid
+// or less accurate than the old bisection
+
+static constexpr double Threshold_MaxError = 1e-4;
+static constexpr int Count_Grid = 10;	  // control points in steps of 0.1, x in [0, 1], y in [-1, 2]
+static constexpr int Count_Progress = 50;
+
+static double ExactProgress(const core::Vec2& p1, const core::Vec2& p2, double x)
+{
+	auto bezier = [](double s, double c1, double c2)
+	{
+		const double u = 1.0 - s;
+		return 3.0 * u * u * s * c1 + 3.0 * u * s * s * c2 + s * s * s;
+	};
+
+	double lo = 0.0, hi = 1.0;
+	for (int i = 0; i < 200; i++)
+	{
+		const double s = 0.5 * (lo + hi);
+		(bezier(s, p1.x, p2.x) < x) ? lo = s : hi = s;
+	}
+	return bezier(0.5 * (lo + hi), p1.y, p2.y);
+}
+
+// cubicBezierProgress before the precomputed solver
+static float BisectionProgress(const core::Vec2& p1, const core::Vec2& p2, float t)
+{
+	t = std::clamp(t, 0.0f, 1.0f);
+
+	auto bezier = [](float s, float p0, float p1, float p2, float p3)
+	{
+		float u = 1.0f - s;
+		return u * u * u * p0 + 3.0f * u * u * s * p1 + 3.0f * u * s * s * p2 + s * s * s * p3;
+	};
+
+	float lo = 0.0f, hi = 1.0f, s = 0.5f;
+	const float eps = 1e-4f;
+	for (int i = 0; i < 256; ++i)
+	{
+		s = 0.5f * (lo + hi);
+		float x = bezier(s, 0.0f, p1.x, p2.x, 1.0f);
+		if (fabsf(x - t) < eps)
+			break;
+		(x < t) ? lo = s : hi = s;
+	}
+
+	return bezier(s, 0.0f, p1.y, p2.y, 1.0f);
+}
+
+int main()
+{
+	double maxError = 0.0;
+	double maxBisectionError = 0.0;
+	core::Vec2 worst[2];
+	float worstX = 0.0f;
+
+	const float step = 1.0f / Count_Grid;
+	for (int a = 0; a <= Count_Grid; a++)
+		for (int b = -Count_Grid; b <= 2 * Count_Grid; b++)
+			for (int c = 0; c <= Count_Grid; c++)
+				for (int d = -Count_Grid; d <= 2 * Count_Grid; d++)
+				{
+					const core::Vec2 p1{a * step, b * step};
+					const core::Vec2 p2{c * step, d * step};
+					core::CubicBezierEasing easing;
+					easing.set(p1, p2);
+
+					for (int i = 0; i <= Count_Progress; i++)
+					{
+						const float x = static_cast<float>(i) / Count_Progress;
+						const double exact = ExactProgress(p1, p2, x);
+						const double error = std::fabs(easing.progress(x) - exact);
+						const double bisectionError = std::fabs(BisectionProgress(p1, p2, x) - exact);
+						maxBisectionError = std::max(maxBisectionError, bisectionError);
+						if (error > maxError)
+						{
+							maxError = error;
+							worst[0] = p1;
+							worst[1] = p2;
+							worstX = x;
+						}
+					}
+				}
+
+	std::printf("max error: solver %g, bisection %g\n", maxError, maxBisectionError);
+	if (maxError > Threshold_MaxError || maxError > maxBisectionError)
+	{
+		std::printf("failed at p1 (%g, %g) p2 (%g, %g) x %g\n", worst[0].x, worst[0].y, worst[1].x, worst[1].y, worstX);
+		return 1;
+	}
+
+	// path morph keys ease with the same solver: a point moving from 0 to 100 over 10 frames
+	{
+		const core::Vec2 out{0.8f, 0.0f};
+		const core::Vec2 in{0.2f, 1.0f};
+		core::PathMorphKeyframes morph;
+		morph.add(0, core::PathPoints{core::PathPoint{.localPosition = {0.0f, 0.0f}}}, {0.0f, 0.0f}, out);
+		morph.add(10, core::PathPoints{core::PathPoint{.localPosition = {100.0f, 0.0f}}}, in, {0.0f, 0.0f});
+		core::PathPoints points(1);
+		morph.frame(3.0f, points);
+		const double expected = 100.0 * ExactProgress(out, in, 0.3);
+		if (std::fabs(points[0].localPosition.x - expected) > 100.0 * Threshold_MaxError)
+		{
+			std::printf("failed: path morph at frame 3 is %g, eased %g\n", points[0].localPosition.x, expected);
+			return 1;
+		}
+	}
+	return 0;
+}
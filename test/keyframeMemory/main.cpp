@@ -0,0 +1,136 @@
+#include "scene/entity.h"
+#include "scene/component/keyframe.h"
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+// the storage of a keyframe track: the key size, the tangent slots that linear and replaced keys give back,
+// and the bytes memoryUsage() and bakeMemoryUsage() report to Scene::memoryReport
+
+using FloatKeys = core::FloatKeyFrame;
+using VectorKeys = core::VectorKeyFrame;
+
+static int gFailCount = 0;
+
+static void Check(bool condition, const char* what)
+{
+	if (!condition)
+	{
+		std::printf("failed: %s\n", what);
+		gFailCount++;
+	}
+}
+
+// tangent slot of every key in frame order
+static std::vector<uint32_t> Slots(FloatKeys& keys)
+{
+	std::vector<uint32_t> slots;
+	for (auto& key : keys)
+	{
+		slots.push_back(key.tangent);
+	}
+	return slots;
+}
+
+int main()
+{
+	constexpr uint32_t Index_Linear = FloatKeys::Index_Linear;
+
+	// a key holds its frame, its value and one slot index, the tangents live in the track
+	Check(sizeof(FloatKeys::Keyframe) == sizeof(uint32_t) * 2 + sizeof(float), "key size: float");
+	Check(sizeof(VectorKeys::Keyframe) == sizeof(uint32_t) * 2 + sizeof(core::Vec2), "key size: vec2");
+
+	// eased keys take one slot each, linear keys none
+	{
+		FloatKeys keys;
+		const FloatKeys::KeyframeDesc descs[] = {
+			{.frame = 0, .value = 0.0f, .outTangent = {0.4f, 0.0f}},
+			{.frame = 10, .value = 1.0f},
+			{.frame = 20, .value = 2.0f, .inTangent = {0.2f, 0.0f}, .outTangent = {0.8f, 1.0f}},
+			{.frame = 30, .value = 3.0f, .inTangent = {0.6f, 1.0f}},
+		};
+		Check(keys.merge(descs, 4), "merge: sorted keys");
+		Check((Slots(keys) == std::vector<uint32_t>{0, Index_Linear, 1, 2}), "merge: slots of the eased keys");
+
+		// replacing an eased key with a linear one releases its slot, markEdited() compacts the others
+		const FloatKeys::KeyframeDesc linear{.frame = 20, .value = 5.0f};
+		keys.merge(&linear, 1);
+		Check((Slots(keys) == std::vector<uint32_t>{0, Index_Linear, Index_Linear, 1}), "merge: slot released");
+		Check(keys.inTangent(*std::next(keys.begin(), 3)).x == 0.6f, "merge: compacted slot keeps its tangents");
+
+		// a new eased key takes the next free slot
+		const FloatKeys::KeyframeDesc eased{.frame = 40, .value = 4.0f, .outTangent = {0.5f, 0.5f}};
+		keys.merge(&eased, 1);
+		Check((Slots(keys) == std::vector<uint32_t>{0, Index_Linear, Index_Linear, 1, 2}), "merge: slot reused");
+
+		// a key dropped on the eased key at 0 replaces it, its slot goes away on markEdited()
+		std::next(keys.begin(), 1)->frame = 0;
+		keys.markEdited(1);
+		Check((Slots(keys) == std::vector<uint32_t>{Index_Linear, Index_Linear, 0, 1}), "markEdited: slots compacted");
+		Check(keys.outTangent(*std::next(keys.begin(), 3)).x == 0.5f, "markEdited: tangents follow their key");
+	}
+
+	// an unanimated property allocates nothing, keys are counted per key
+	{
+		FloatKeys keys;
+		Check(keys.memoryUsage() == 0 && keys.bakeMemoryUsage() == 0, "report: unanimated track");
+		keys.add(0, 0.0f);
+		const size_t oneKey = keys.memoryUsage();
+		keys.add(10, 1.0f);
+		keys.add(20, 2.0f);
+		Check(oneKey > 0 && keys.memoryUsage() >= oneKey + sizeof(FloatKeys::Keyframe), "report: keys are counted");
+	}
+
+	// linear tracks are not baked, eased tracks are and the samples are their own line in the report
+	{
+		VectorKeys keys;
+		keys.add(0, core::Vec2{0.0f, 0.0f});
+		keys.add(200, core::Vec2{100.0f, 50.0f});
+		core::BakeBudget budget;
+		budget.samples = 1 << 16;
+		keys.bake(0, 200, budget);
+		Check(keys.bakeMemoryUsage() == 0, "bake: linear track is not baked");
+
+		const VectorKeys::KeyframeDesc eased{
+			.frame = 100, .value = core::Vec2{20.0f, 10.0f}, .inTangent = {0.3f, 0.0f}, .outTangent = {0.7f, 1.0f}};
+		keys.merge(&eased, 1);
+		const size_t keyBytes = keys.memoryUsage();
+		keys.bake(0, 200, budget);
+		Check(keys.bakeMemoryUsage() == 201 * sizeof(core::Vec2), "bake: one sample per frame");
+		Check(keys.memoryUsage() == keyBytes, "bake: not counted with the keys");
+
+		// quantized samples take 16 bits per channel
+		const core::Vec2 exact = keys.frame(50.0f);
+		core::BakeBudget quantized;
+		quantized.samples = 1 << 16;
+		quantized.isQuantized = true;
+		keys.bake(0, 200, quantized);
+		Check(keys.bakeMemoryUsage() == 201 * 2 * sizeof(uint16_t), "quantize: 16 bits per channel");
+		const core::Vec2 sample = keys.frame(50.0f);
+		Check(std::fabs(sample.x - exact.x) < 0.01f && std::fabs(sample.y - exact.y) < 0.01f,
+			  "quantize: within one level");
+
+		// a fractional frame reads between the quantized samples around it, not the exact curve one level away
+		const core::Vec2 lo = keys.frame(50.0f);
+		const core::Vec2 hi = keys.frame(51.0f);
+		const core::Vec2 half = keys.frame(50.5f);
+		Check(half.x == lo.x + (hi.x - lo.x) * 0.5f && half.y == lo.y + (hi.y - lo.y) * 0.5f,
+			  "quantize: sub-frames follow the samples");
+
+		// a key added during a live drag makes the samples stale without freeing them
+		keys.bake(0, 200, budget);
+		keys.add(150, core::Vec2{-30.0f, -30.0f});
+		Check(keys.frame(150.0f).x == -30.0f, "add: stale samples are not read");
+		Check(keys.bakeMemoryUsage() == 201 * sizeof(core::Vec2), "add: sample storage kept");
+		keys.bake(0, 200, budget);
+		Check(keys.frame(150.0f).x == -30.0f, "add: baked again");
+
+		keys.markEdited();
+		Check(keys.bakeMemoryUsage() == 0, "edit: the bake is released");
+	}
+
+	if (gFailCount == 0)
+		std::printf("keyframe memory: ok\n");
+	return gFailCount == 0 ? 0 : 1;
+}
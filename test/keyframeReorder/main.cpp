@@ -0,0 +1,133 @@
+#include "scene/entity.h"
+#include "scene/component/keyframe.h"
+
+#include <cstdio>
+#include <vector>
+
+// the timeline drags Keyframe::frame in place and then calls markEdited(movedIndex), the way
+// ImguiTimeline::drawKeyframe does. the keys must come back sorted with their values and tangents,
+// and a key dropped on another key's frame must replace it
+
+using FloatKeys = core::FloatKeyFrame;
+
+static int gFailCount = 0;
+
+static void Check(bool condition, const char* what)
+{
+	if (!condition)
+	{
+		std::printf("failed: %s\n", what);
+		gFailCount++;
+	}
+}
+
+static void Drag(FloatKeys& keys, size_t index, uint32_t frameNo)
+{
+	size_t i = 0;
+	for (auto& key : keys)
+	{
+		if (i++ == index)
+			key.frame = frameNo;
+	}
+	keys.markEdited(index);
+}
+
+static std::vector<uint32_t> Frames(FloatKeys& keys)
+{
+	std::vector<uint32_t> frames;
+	for (auto& key : keys)
+	{
+		frames.push_back(key.frame);
+	}
+	return frames;
+}
+
+static const FloatKeys::Keyframe* At(FloatKeys& keys, uint32_t frameNo)
+{
+	for (auto& key : keys)
+	{
+		if (key.frame == frameNo)
+			return &key;
+	}
+	return nullptr;
+}
+
+// keys at 0, 10, 20 and 30 with values 0, 1, 2 and 3, the key at 10 is eased
+static void Setup(FloatKeys& keys)
+{
+	const FloatKeys::KeyframeDesc descs[] = {
+		{.frame = 0, .value = 0.0f},
+		{.frame = 10, .value = 1.0f, .inTangent = {0.2f, 0.0f}, .outTangent = {0.8f, 1.0f}},
+		{.frame = 20, .value = 2.0f},
+		{.frame = 30, .value = 3.0f},
+	};
+	keys.merge(descs, 4);
+}
+
+int main()
+{
+	// drag the eased key past its right neighbour: 0, 20, 25, 30
+	{
+		FloatKeys keys;
+		Setup(keys);
+		Drag(keys, 1, 25);
+		Check((Frames(keys) == std::vector<uint32_t>{0, 20, 25, 30}), "drag right: sorted frames");
+		const auto* moved = At(keys, 25);
+		Check(moved && moved->value == 1.0f, "drag right: value moved with the key");
+		Check(moved && keys.outTangent(*moved).x == 0.8f && keys.inTangent(*moved).x == 0.2f,
+			  "drag right: tangents moved with the key");
+		Check(keys.frame(20.0f) == 2.0f && keys.frame(30.0f) == 3.0f, "drag right: values at the keys");
+		Check(keys.frame(10.0f) == 1.0f, "drag right: interpolates between the sorted keys");
+	}
+
+	// drag the last key before the first: 0, 5, 10, 20 with the dragged value at 5
+	{
+		FloatKeys keys;
+		Setup(keys);
+		Drag(keys, 3, 5);
+		Check((Frames(keys) == std::vector<uint32_t>{0, 5, 10, 20}), "drag left: sorted frames");
+		Check(keys.frame(5.0f) == 3.0f && keys.frame(20.0f) == 2.0f, "drag left: values at the keys");
+		Check(keys.frame(15.0f) != 1.0f, "drag left: interpolates between the sorted keys");
+	}
+
+	// drop the last key on the eased key: it replaces the eased key and its tangents are released
+	{
+		FloatKeys keys;
+		Setup(keys);
+		Drag(keys, 3, 10);
+		Check((Frames(keys) == std::vector<uint32_t>{0, 10, 20}), "drop: one key per frame");
+		const auto* dropped = At(keys, 10);
+		Check(dropped && dropped->value == 3.0f, "drop: the dragged key wins");
+		Check(dropped && dropped->tangent == FloatKeys::Index_Linear, "drop: the replaced key's tangents are gone");
+	}
+
+	// drop the eased key on a linear key: the eased key and its tangents are kept
+	{
+		FloatKeys keys;
+		Setup(keys);
+		Drag(keys, 1, 20);
+		Check((Frames(keys) == std::vector<uint32_t>{0, 20, 30}), "drop eased: one key per frame");
+		const auto* dropped = At(keys, 20);
+		Check(dropped && dropped->value == 1.0f && keys.outTangent(*dropped).x == 0.8f,
+			  "drop eased: value and tangents kept");
+	}
+
+	// seek and add still work on the reordered track
+	{
+		FloatKeys keys;
+		Setup(keys);
+		for (float frameNo = 0.0f; frameNo <= 30.0f; frameNo += 1.0f)
+		{
+			keys.frame(frameNo);	// leaves the seek cursor on the last key
+		}
+		Drag(keys, 0, 40);
+		Check((Frames(keys) == std::vector<uint32_t>{10, 20, 30, 40}), "cursor: sorted frames");
+		Check(keys.frame(40.0f) == 0.0f && keys.frame(30.0f) == 3.0f, "cursor: values after the reorder");
+		keys.add(35, 7.0f);
+		Check((Frames(keys) == std::vector<uint32_t>{10, 20, 30, 35, 40}), "add: inserted in order");
+	}
+
+	if (gFailCount == 0)
+		std::printf("keyframe reorder: ok\n");
+	return gFailCount == 0 ? 0 : 1;
+}
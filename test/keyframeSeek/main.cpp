@@ -0,0 +1,99 @@
+#include "scene/entity.h"
+#include "scene/component/keyframe.h"
+#include "../common/benchmark.h"
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// cost of Keyframes::frame() against the key count, for playback (frames moving forward in small steps) and
+// scrubbing (random frames). the reference is what frame() did before the seek cursor: a binary search per call
+
+static constexpr int Count_Call = 2000000;
+static constexpr uint32_t Step_KeyFrame = 10;
+
+struct ReferenceKey
+{
+	uint32_t frame;
+	float value;
+};
+
+static float ReferenceFrame(const std::vector<ReferenceKey>& keys, float frameNo)
+{
+	auto it = std::lower_bound(keys.begin(), keys.end(), frameNo,
+							   [](const ReferenceKey& k, float f) { return k.frame < f; });
+	if (it == keys.end())
+		return keys.back().value;
+	if (it == keys.begin())
+		return keys.front().value;
+
+	const auto& lo = *(it - 1);
+	const auto& hi = *it;
+	const float u = (frameNo - static_cast<float>(lo.frame)) / float(hi.frame - lo.frame);
+	return lo.value + (hi.value - lo.value) * u;
+}
+
+int main()
+{
+	volatile float sink = 0.0f;	   // keeps the evaluated values alive
+
+	std::printf("%8s %18s %18s %18s %18s\n", "keys", "play (ns)", "play ref (ns)", "scrub (ns)", "scrub ref (ns)");
+	for (uint32_t keyCount : {4u, 64u, 1024u, 16384u})
+	{
+		core::FloatKeyFrame keyframes;
+		std::vector<ReferenceKey> reference;
+		for (uint32_t i = 0; i < keyCount; i++)
+		{
+			const float value = static_cast<float>((i * 37) % 101);
+			keyframes.add(i * Step_KeyFrame, value);
+			reference.push_back({i * Step_KeyFrame, value});
+		}
+
+		// playback in quarter frames, wrapping at the last key
+		const float lastFrame = static_cast<float>((keyCount - 1) * Step_KeyFrame);
+		std::vector<float> playFrames(Count_Call);
+		for (int i = 0; i < Count_Call; i++)
+		{
+			playFrames[i] = std::fmod(i * 0.25f, lastFrame);
+		}
+		std::vector<float> scrubFrames(Count_Call);
+		std::mt19937 rng(keyCount);
+		std::uniform_real_distribution<float> pick(0.0f, lastFrame);
+		for (auto& frameNo : scrubFrames)
+		{
+			frameNo = pick(rng);
+		}
+
+		auto run = [&](const std::vector<float>& frames, auto evaluate)
+		{
+			return Measure<std::nano>(
+					   [&]
+					   {
+						   float sum = 0.0f;
+						   for (float frameNo : frames)
+						   {
+							   sum += evaluate(frameNo);
+						   }
+						   sink = sum;
+					   }) /
+				   Count_Call;
+		};
+		auto cursor = [&](float frameNo) { return keyframes.frame(frameNo); };
+		auto binarySearch = [&](float frameNo) { return ReferenceFrame(reference, frameNo); };
+
+		// the cursor must give the same values as the binary search
+		for (int i = 0; i < Count_Call; i += 97)
+		{
+			if (keyframes.frame(playFrames[i]) != ReferenceFrame(reference, playFrames[i]) ||
+				keyframes.frame(scrubFrames[i]) != ReferenceFrame(reference, scrubFrames[i]))
+			{
+				std::printf("mismatch at %d keys\n", keyCount);
+				return 1;
+			}
+		}
+
+		std::printf("%8u %18.2f %18.2f %18.2f %18.2f\n", keyCount, run(playFrames, cursor),
+					run(playFrames, binarySearch), run(scrubFrames, cursor), run(scrubFrames, binarySearch));
+	}
+	return 0;
+}
@@ -0,0 +1,46 @@
+#include "scene/scene.h"
+#include "scene/component/components.h"
+
+#include "../common/benchmark.h"
+
+#include <thorvg.h>
+
+#include <cstdio>
+#include <vector>
+
+// cost of filling a scene with primitive layers: one create*Layer call per layer (updated and pushed one by one)
+// next to Scene::createLayers, whose layers are built by the following onUpdate and pushed together
+
+int main()
+{
+	tvg::Initializer::init(0);
+	{
+		std::printf("%8s %18s %18s\n", "layers", "per layer (ms)", "createLayers (ms)");
+		for (int layerCount : {1000, 10000, 100000})
+		{
+			const double singleMs = Measure<std::milli>(
+				[&]
+				{
+					core::Scene scene;
+					for (int i = 0; i < layerCount; i++)
+					{
+						scene.createRectFillLayer(GridPosition(i), {8.0f, 8.0f});
+					}
+					scene.onUpdate();
+				});
+
+			const auto descriptors = GridDescriptors(layerCount);
+			const double batchMs = Measure<std::milli>(
+				[&]
+				{
+					core::Scene scene;
+					scene.createLayers(descriptors.data(), descriptors.size());
+					scene.onUpdate();
+				});
+
+			std::printf("%8d %18.2f %18.2f\n", layerCount, singleMs, batchMs);
+		}
+	}
+	tvg::Initializer::term();
+	return 0;
+}
@@ -0,0 +1,59 @@
+#include "scene/scene.h"
+#include "scene/component/components.h"
+
+#include "../common/benchmark.h"
+
+#include <thorvg.h>
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// cost of one marquee update at 100k layers: Scene::rectCandidates for a rect of the given size at random
+// places of the grid, the query PickMode runs on every drag event. the budget is 1 ms per query.
+// the first query also builds the spatial index, it is reported on its own
+
+static constexpr int Count_Layer = 100000;
+static constexpr int Count_Query = 200;
+static constexpr double Threshold_BudgetMs = 1.0;
+
+int main()
+{
+	tvg::Initializer::init(0);
+	{
+		core::Scene scene;
+		const auto descriptors = GridDescriptors(Count_Layer);
+		scene.createLayers(descriptors.data(), descriptors.size());
+		scene.onUpdate();
+
+		const core::Vec2 gridMax = GridPosition(Count_Layer - 1) + core::Vec2{8.0f, 8.0f};
+		std::vector<core::Entity> out;
+		const double buildMs = Measure<std::milli>([&] { scene.rectCandidates({0.0f, 0.0f}, {10.0f, 10.0f}, out); });
+		std::printf("%d layers, first query (index build) %.2f ms\n", Count_Layer, buildMs);
+
+		std::printf("%10s %12s %14s %8s\n", "rect", "layers/op", "query (ms/op)", "budget");
+		std::mt19937 rng(Count_Layer);
+		for (float size : {50.0f, 200.0f, 800.0f, 2560.0f})
+		{
+			std::uniform_real_distribution<float> x(0.0f, std::max(gridMax.x - size, 0.0f));
+			std::uniform_real_distribution<float> y(0.0f, std::max(gridMax.y - size, 0.0f));
+			size_t found = 0;
+			const double queryMs = Measure<std::milli>(
+				[&]
+				{
+					for (int i = 0; i < Count_Query; i++)
+					{
+						const core::Vec2 minXy{x(rng), y(rng)};
+						out.clear();
+						scene.rectCandidates(minXy, minXy + core::Vec2{size, size}, out);
+						found += out.size();
+					}
+				});
+			const double perQueryMs = queryMs / Count_Query;
+			std::printf("%10.0f %12zu %14.3f %8s\n", size, found / Count_Query, perQueryMs,
+						perQueryMs < Threshold_BudgetMs ? "ok" : "over");
+		}
+	}
+	tvg::Initializer::term();
+	return 0;
+}
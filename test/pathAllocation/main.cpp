@@ -0,0 +1,95 @@
+#include "scene/scene.h"
+#include "scene/component/components.h"
+
+#include <thorvg.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+// rebuilding the tvg path of an animated shape must not allocate once its private path segments have grown
+// to their steady size. counts global operator new over the animated frames
+
+static size_t gAllocationCount = 0;
+
+void* operator new(std::size_t size)
+{
+	gAllocationCount++;
+	if (void* ptr = std::malloc(size ? size : 1))
+		return ptr;
+	std::abort();	 // built without exceptions
+}
+
+void operator delete(void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+	std::free(ptr);
+}
+
+static constexpr int Count_PathPoint = 64;
+static constexpr int Count_WarmUpFrame = 3;
+static constexpr uint32_t Count_Frame = 100;
+
+static core::PathPoints Circle(float radius)
+{
+	core::PathPoints points(Count_PathPoint);
+	for (int i = 0; i < Count_PathPoint; i++)
+	{
+		const float radian = core::ToRadian(360.0f * i / Count_PathPoint);
+		points[i].localPosition = {radius * std::cos(radian), radius * std::sin(radian)};
+		points[i].type = i == 0 ? core::PathPoint::Command::MoveTo : core::PathPoint::Command::LineTo;
+	}
+	points.push_back(core::PathPoint{.type = core::PathPoint::Command::Close});
+	return points;
+}
+
+int main()
+{
+	tvg::Initializer::init(0);
+	size_t allocationCount = 0;
+	{
+		core::ShapeComponent shape;
+		shape.shape = tvg::Shape::gen();
+		shape.shape->ref();
+
+		// a morphing raw path next to a polygon that keeps its geometry
+		core::PathListComponent pathList;
+		auto rawPath = std::make_unique<core::RawPath>();
+		rawPath->path = Circle(50.0f);
+		rawPath->morphKeyframes.add(0, Circle(50.0f));
+		rawPath->morphKeyframes.add(Count_Frame, Circle(100.0f));
+		pathList.paths.push_back(std::move(rawPath));
+		pathList.paths.push_back(std::make_unique<core::PolygonPath>());
+
+		auto rebuild = [&](uint32_t frameNo)
+		{
+			for (auto& path : pathList.paths)
+			{
+				path->update(static_cast<float>(frameNo));
+			}
+			core::Update(shape, pathList, false);
+		};
+
+		for (uint32_t frameNo = 0; frameNo < Count_WarmUpFrame; frameNo++)
+		{
+			rebuild(frameNo);
+		}
+
+		const size_t before = gAllocationCount;
+		for (uint32_t frameNo = Count_WarmUpFrame; frameNo <= Count_Frame; frameNo++)
+		{
+			rebuild(frameNo);
+		}
+		allocationCount = gAllocationCount - before;
+
+		shape.shape->unref();
+	}
+	tvg::Initializer::term();
+
+	std::printf("allocations over %u rebuilt frames: %zu\n", Count_Frame + 1 - Count_WarmUpFrame, allocationCount);
+	return allocationCount == 0 ? 0 : 1;
+}
@@ -0,0 +1,157 @@
+#include "scene/entity.h"
+#include "scene/component/pathSimplify.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+// SimplifyPath on a dense polyline and on a sampled circle: the point count must drop, the reported error must
+// stay within the tolerance, and every input point must lie within the tolerance of the simplified outline
+
+static constexpr float Threshold_Tolerance = 0.5f;
+static constexpr int Count_CurveStep = 64;	  // samples per output segment when measuring the result
+
+static int gFailCount = 0;
+
+static void Check(bool condition, const char* what)
+{
+	if (!condition)
+	{
+		std::printf("failed: %s\n", what);
+		gFailCount++;
+	}
+}
+
+static float Distance(const core::Vec2& a, const core::Vec2& b)
+{
+	const core::Vec2 d = a - b;
+	return std::sqrt(d * d);
+}
+
+static float DistanceToSegment(const core::Vec2& p, const core::Vec2& a, const core::Vec2& b)
+{
+	const core::Vec2 ab = b - a;
+	const float len2 = ab * ab;
+	const float t = len2 > 0.0f ? std::clamp(((p - a) * ab) / len2, 0.0f, 1.0f) : 0.0f;
+	return Distance(p, a + ab * t);
+}
+
+// the simplified outline sampled densely, the closing segment included
+static std::vector<core::Vec2> Sample(const core::PathPoints& points)
+{
+	std::vector<core::Vec2> out{points[0].localPosition};
+	auto addSegment = [&out](const core::PathPoint& from, const core::PathPoint& to)
+	{
+		if (to.type != core::PathPoint::Command::CubicTo)
+		{
+			out.push_back(to.localPosition);
+			return;
+		}
+		const core::Vec2 p0 = from.localPosition;
+		const core::Vec2 c1 = p0 + from.deltaRightControlPosition;
+		const core::Vec2 c2 = to.localPosition + to.deltaLeftControlPosition;
+		const core::Vec2 p3 = to.localPosition;
+		for (int k = 1; k <= Count_CurveStep; k++)
+		{
+			const float t = static_cast<float>(k) / Count_CurveStep;
+			const float mt = 1.0f - t;
+			out.push_back(p0 * (mt * mt * mt) + c1 * (3.0f * mt * mt * t) + c2 * (3.0f * mt * t * t) +
+						  p3 * (t * t * t));
+		}
+	};
+
+	const bool isClosed = points.back().type == core::PathPoint::Command::Close;
+	const size_t count = isClosed ? points.size() - 1 : points.size();
+	for (size_t i = 1; i < count; i++)
+	{
+		addSegment(points[i - 1], points[i]);
+	}
+	if (isClosed)
+	{
+		core::PathPoint closing = points[0];
+		closing.type = points[count - 1].type;
+		addSegment(points[count - 1], closing);
+	}
+	return out;
+}
+
+static float MeasureError(const std::vector<core::Vec2>& input, const core::PathPoints& simplified)
+{
+	const auto outline = Sample(simplified);
+	float maxError = 0.0f;
+	for (const auto& p : input)
+	{
+		float error = Distance(p, outline[0]);
+		for (size_t i = 1; i < outline.size(); i++)
+		{
+			error = std::min(error, DistanceToSegment(p, outline[i - 1], outline[i]));
+		}
+		maxError = std::max(maxError, error);
+	}
+	return maxError;
+}
+
+static void Run(const char* name, const std::vector<core::Vec2>& input, bool isClosed)
+{
+	core::RawPath path;
+	path.path.push_back({.localPosition = input[0], .type = core::PathPoint::Command::MoveTo});
+	for (size_t i = 1; i < input.size(); i++)
+	{
+		path.path.push_back({.localPosition = input[i], .type = core::PathPoint::Command::LineTo});
+	}
+	if (isClosed)
+		path.path.push_back({.type = core::PathPoint::Command::Close});
+
+	const size_t inputCount = path.path.size();
+	const auto result = core::SimplifyPath(path, Threshold_Tolerance);
+	const float measured = result.isSimplified ? MeasureError(input, path.path) : 0.0f;
+	std::printf("%-10s %6zu -> %4zu points, reported error %.4f, measured %.4f\n", name, result.inputPointCount,
+				result.outputPointCount, result.maxError, measured);
+
+	char what[128];
+	std::snprintf(what, sizeof(what), "%s: simplified", name);
+	Check(result.isSimplified, what);
+	std::snprintf(what, sizeof(what), "%s: fewer points", name);
+	Check(result.inputPointCount == inputCount && result.outputPointCount < inputCount / 4 &&
+			  result.outputPointCount == path.path.size(),
+		  what);
+	std::snprintf(what, sizeof(what), "%s: reported error within tolerance", name);
+	Check(result.maxError <= Threshold_Tolerance, what);
+	std::snprintf(what, sizeof(what), "%s: outline within tolerance", name);
+	Check(measured <= Threshold_Tolerance, what);
+	if (isClosed)
+	{
+		std::snprintf(what, sizeof(what), "%s: stays closed", name);
+		Check(path.path.back().type == core::PathPoint::Command::Close, what);
+	}
+}
+
+int main()
+{
+	// a hand-drawn stroke: a slow wave sampled every half unit
+	{
+		std::vector<core::Vec2> polyline;
+		for (int i = 0; i < 2000; i++)
+		{
+			const float x = i * 0.5f;
+			polyline.push_back(core::Vec2{x, 40.0f * std::sin(x * 0.02f) + 10.0f * std::sin(x * 0.07f)});
+		}
+		Run("polyline", polyline, false);
+	}
+
+	// a circle of radius 100 sampled every degree
+	{
+		std::vector<core::Vec2> circle;
+		for (int i = 0; i < 360; i++)
+		{
+			const float radian = i * 3.14159265f / 180.0f;
+			circle.push_back(core::Vec2{100.0f * std::cos(radian), 100.0f * std::sin(radian)});
+		}
+		Run("circle", circle, true);
+	}
+
+	if (gFailCount == 0)
+		std::printf("path simplify: ok\n");
+	return gFailCount == 0 ? 0 : 1;
+}